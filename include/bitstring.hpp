@@ -5,7 +5,26 @@
 
 #include "bitstring/exceptions.hpp"
 #include "bitstring/endian.hpp"
+#include "bitstring/bit_view.hpp"
+#include "bitstring/algorithm.hpp"
 #include "bitstring/bit_array.hpp"
+#include "bitstring/bit_array_pool.hpp"
+#include "bitstring/concurrent_bit_array.hpp"
+#include "bitstring/fixed_bit_array.hpp"
+#include "bitstring/run_bit_array.hpp"
+#include "bitstring/bit_layout.hpp"
+#include "bitstring/bit_stream.hpp"
+#include "bitstring/bit_fifo.hpp"
+#include "bitstring/crc.hpp"
+#include "bitstring/hash.hpp"
+#include "bitstring/integer_codes.hpp"
+#include "bitstring/interleave.hpp"
+#include "bitstring/lfsr.hpp"
+#include "bitstring/line_coding.hpp"
+#include "bitstring/packing.hpp"
+#include "bitstring/prefix_code.hpp"
+#include "bitstring/serialization.hpp"
+#include "bitstring/stats.hpp"
 #include "bitstring/literals.hpp"
 
 #endif
@@ -0,0 +1,118 @@
+#ifndef header_bitstring_algorithm_hpp
+#define header_bitstring_algorithm_hpp
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_view.hpp"
+
+namespace bitstring {
+
+namespace execution {
+struct sequenced_policy {};
+
+// Bulk operations are split into chunks of chunk_bits (rounded to storage
+// units) which are processed by up to threads threads (0: one per hardware
+// thread). Inputs shorter than min_bits are processed sequentially as
+// starting threads would cost more than it gains.
+struct parallel_policy {
+  unsigned int threads{0};
+  std::size_t chunk_bits{std::size_t{1} << 21U};
+  std::size_t min_bits{std::size_t{1} << 23U};
+};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+} // namespace execution
+
+inline constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+// number of set bits
+std::size_t count(bit_view bits) noexcept;
+std::size_t count(const execution::parallel_policy &policy, bit_view bits);
+
+// index of the first occurrence of needle at or after start, npos if none
+std::size_t find(bit_view haystack, bit_view needle,
+                 std::size_t start = 0) noexcept;
+std::size_t find(const execution::parallel_policy &policy, bit_view haystack,
+                 bit_view needle, std::size_t start = 0);
+
+// number of positions at which a and b differ, std::length_error if the
+// sizes differ
+std::size_t hamming_distance(bit_view a, bit_view b);
+
+// every offset (ascending) at which pattern matches haystack with at most
+// max_errors differing bits
+std::vector<std::size_t> correlate(bit_view haystack, bit_view pattern,
+                                   std::size_t max_errors);
+
+// the bits of bits at the positions where mask is set, in order
+// (std::length_error if the sizes differ)
+bit_array extract(bit_view bits, bit_view mask);
+// inverse of extract: mask.size() bits with values scattered to the set
+// positions of mask and 0 elsewhere (std::length_error unless values has
+// exactly one bit per set mask bit)
+bit_array deposit(bit_view mask, bit_view values);
+
+// position of the first bit at which a and b differ; the size of the
+// shorter one if it is a prefix of the other, npos if both are equal
+std::size_t first_mismatch(bit_view a, bit_view b) noexcept;
+
+// half-open range of bit positions [pos, pos + length)
+struct bit_range {
+  std::size_t pos;
+  std::size_t length;
+
+  bool operator==(const bit_range &o) const noexcept {
+    return pos == o.pos && length == o.length;
+  }
+  bool operator!=(const bit_range &o) const noexcept { return !(*this == o); }
+};
+
+// maximal ranges (ascending) in which a and b differ, at most max_ranges.
+// Bits beyond the end of the shorter one count as differing.
+std::vector<bit_range> diff(bit_view a, bit_view b,
+                            std::size_t max_ranges = npos);
+// multi-line report of the differences for test failures: sizes, number of
+// differing bits and ranges, and the bits of both sides for the first
+// max_ranges ranges; empty if a and b are equal
+std::string diff_summary(bit_view a, bit_view b, std::size_t max_ranges = 8);
+
+bool equal(const execution::parallel_policy &policy, bit_view a, bit_view b);
+bool starts_with(const execution::parallel_policy &policy, bit_view bits,
+                 bit_view prefix);
+std::string bin(const execution::parallel_policy &policy, bit_view bits);
+
+// sort into lexicographic order (see compare) using an MSD radix sort on
+// 8 bit digits, small buckets fall back to comparison sorting
+void radix_sort(std::vector<bit_array> &arrays);
+
+inline std::size_t count(const execution::sequenced_policy & /*unused*/,
+                         bit_view bits) noexcept {
+  return count(bits);
+}
+inline std::size_t find(const execution::sequenced_policy & /*unused*/,
+                        bit_view haystack, bit_view needle,
+                        std::size_t start = 0) noexcept {
+  return find(haystack, needle, start);
+}
+inline bool equal(const execution::sequenced_policy & /*unused*/, bit_view a,
+                  bit_view b) noexcept {
+  return a == b;
+}
+inline bool starts_with(const execution::sequenced_policy & /*unused*/,
+                        bit_view bits, bit_view prefix) noexcept {
+  return prefix.size() <= bits.size() &&
+         bits.subview(0, prefix.size()) == prefix;
+}
+inline std::string bin(const execution::sequenced_policy & /*unused*/,
+                       bit_view bits) {
+  return bits.bin();
+}
+
+} // namespace bitstring
+
+#endif
@@ -9,6 +9,8 @@
 #include <type_traits>
 #include <vector>
 
+#include "bitstring/bit_ops.hpp"
+#include "bitstring/bit_view.hpp"
 #include "bitstring/endian.hpp"
 
 namespace bitstring {
@@ -49,6 +51,8 @@ class bit_array {
 public:
   using storage_type = std::uint32_t;
   using bitcnt_t = std::size_t;
+  static_assert(std::is_same<storage_type, bit_view::storage_type>::value,
+                "bit_view must be able to view bit_array storage");
 
 private:
   std::vector<storage_type> bits_;
@@ -61,6 +65,9 @@ public:
   explicit bit_array(std::string_view);
 #endif // __cpp_lib_string_view
   explicit bit_array(std::vector<uint8_t>);
+  explicit bit_array(bit_view);
+  // adopt storage units (LSB first) holding bitcnt bits
+  bit_array(std::vector<storage_type> units, bitcnt_t bitcnt);
   template <typename T,
             typename std::enable_if<std::is_integral<T>::value &&
                                         std::is_unsigned<T>::value &&
@@ -92,12 +99,21 @@ public:
 
   bit_array &append(bool bit);
   bit_array &append(const bit_array &b);
+  bit_array &append(bit_view b);
   bit_array &prepend(const bit_array &b);
 #ifdef __cpp_lib_string_view
   bit_array &append(std::string_view);
   bit_array &prepend(std::string_view);
+  // would otherwise silently pick append(bool)
+  bit_array &append(const char *s) { return append(std::string_view(s)); }
 #endif
 
+  // in place, bit i moves to (i - n) mod size() / (i + n) mod size()
+  bit_array &rotate_left(bitcnt_t n);
+  bit_array &rotate_right(bitcnt_t n);
+  // in place, bit i moves to size() - 1 - i
+  bit_array &reverse();
+
   bit_array front(bitcnt_t bits);
   // back
   // substr
@@ -112,14 +128,21 @@ public:
   bool starts_with(const bit_array &other) const noexcept;
 
   const std::vector<storage_type> &data() const;
+  bit_view view() const noexcept {
+    return bit_view(bits_.data(), offset_, bitcnt_);
+  }
+  operator bit_view() const noexcept { return view(); }
 
 private:
   detail::bit_index shifted_idx(bitcnt_t idx) const noexcept {
     return detail::bit_index(idx + offset_);
   }
   bool compare_fast(const bit_array &other) const noexcept;
+  void compact_front();
   bool compare_slow(const bit_array &other) const noexcept;
 
+  friend bit_array operator*(size_t cnt, const bit_array &ba);
+
 public:
   template <typename T>
   static constexpr size_t storage_units(size_t cnt) noexcept {
@@ -152,7 +175,7 @@ bit_array::bit_array(T v, size_t bits, bitorder bio /* = lsb_first */)
     v = detail::bitflipped(v);
     v >>= 8 * sizeof(T) - bits;
   }
-  for (size_t i = 0; i < storage_units<T>(1); i++) {
+  for (size_t i = 0; i < storage_units<T>(1) && i < bits_.size(); i++) {
     // TODO: think about UB in the shift
     auto unit = static_cast<storage_type>(v >> (sizeof(storage_type) * i * 8));
     bits_[i] = unit;
@@ -0,0 +1,104 @@
+#ifndef header_bitstring_bit_array_pool_hpp
+#define header_bitstring_bit_array_pool_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_view.hpp"
+
+namespace bitstring {
+
+// Append-only container for many short bit sequences. All sequences are
+// stored back to back in one buffer of storage units, the index holds a
+// 32 bit end position per sequence relative to the start of its block of
+// 64 sequences, so the overhead is about 33 bits per sequence. The bits of
+// one block must not exceed 2^32 (std::length_error otherwise).
+//
+// Views handed out are invalidated by push_back, like vector iterators.
+class bit_array_pool {
+public:
+  using storage_type = bit_view::storage_type;
+  using bitcnt_t = std::size_t;
+
+  class const_iterator {
+    const bit_array_pool *pool_;
+    std::size_t idx_;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = bit_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = bit_view;
+
+    const_iterator(const bit_array_pool *pool, std::size_t idx) noexcept
+        : pool_(pool), idx_(idx) {}
+
+    bit_view operator*() const noexcept { return (*pool_)[idx_]; }
+    const_iterator &operator++() noexcept {
+      idx_++;
+      return *this;
+    }
+    const_iterator operator++(int) noexcept {
+      auto ret = *this;
+      idx_++;
+      return ret;
+    }
+    bool operator==(const const_iterator &o) const noexcept {
+      return idx_ == o.idx_;
+    }
+    bool operator!=(const const_iterator &o) const noexcept {
+      return idx_ != o.idx_;
+    }
+  };
+
+private:
+  static constexpr std::size_t block_size = 64;
+
+  std::vector<storage_type> units_;
+  // bit position where each block of sequences starts
+  std::vector<bitcnt_t> block_starts_;
+  // end of each sequence relative to the start of its block
+  std::vector<std::uint32_t> ends_;
+
+public:
+  bit_array_pool() = default;
+
+  bit_array_pool &reserve(std::size_t sequences, bitcnt_t bits);
+  // returns the index of the new sequence
+  std::size_t push_back(bit_view bits);
+  void clear() noexcept;
+
+  std::size_t size() const noexcept { return ends_.size(); }
+  bool empty() const noexcept { return ends_.empty(); }
+  // total number of bits of all sequences
+  bitcnt_t bit_count() const noexcept {
+    return ends_.empty() ? 0 : end_of(ends_.size() - 1);
+  }
+
+  bit_view operator[](std::size_t idx) const noexcept {
+    const auto first = idx % block_size == 0 ? block_starts_[idx / block_size]
+                                             : end_of(idx - 1);
+    return bit_view(units_.data(), first, end_of(idx) - first);
+  }
+  const_iterator begin() const noexcept { return {this, 0}; }
+  const_iterator end() const noexcept { return {this, size()}; }
+
+  // equal pools hold the same sequences, which are packed identically
+  bool operator==(const bit_array_pool &o) const noexcept;
+  bool operator!=(const bit_array_pool &o) const noexcept {
+    return !(*this == o);
+  }
+
+private:
+  bitcnt_t end_of(std::size_t idx) const noexcept {
+    return block_starts_[idx / block_size] + ends_[idx];
+  }
+};
+
+} // namespace bitstring
+
+#endif
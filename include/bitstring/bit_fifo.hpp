@@ -0,0 +1,72 @@
+#ifndef header_bitstring_bit_fifo_hpp
+#define header_bitstring_bit_fifo_hpp
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_view.hpp"
+
+namespace bitstring {
+
+// Lock-free ring buffer of bits between exactly one producer thread (write
+// functions) and one consumer thread (read functions). Positions are kept
+// in bits and published with release/acquire ordering; each side caches
+// the other side's position and only reloads it when it runs out of room
+// or data, so the shared counters are not bounced between cores on every
+// call.
+//
+// The ring is made of storage units and wraps at unit granularity. The
+// unit holding the write position is shared by both sides, so units are
+// accessed through relaxed atomics and reads copy out of the ring. Up to
+// one unit of the capacity is unavailable to the producer while the
+// consumer is in the middle of a unit.
+class bit_fifo {
+public:
+  using storage_type = bit_view::storage_type;
+
+  static constexpr std::size_t cache_line_bytes = 64;
+
+  // the capacity is rounded up to a power of two number of storage units
+  explicit bit_fifo(std::size_t capacity_bits);
+
+  std::size_t capacity() const noexcept { return (mask_ + 1) * unit_bits; }
+
+  // producer: append all bits or, if there is not enough room, none
+  bool write(bit_view bits);
+  // producer: append the low n <= 64 bits of value, bit 0 first
+  bool write_bits(std::uint64_t value, std::size_t n);
+
+  // consumer: number of bits available for reading
+  std::size_t size() const noexcept;
+  // consumer: take up to n bits, fewer if less are available
+  bit_array read(std::size_t n);
+
+private:
+  static constexpr std::size_t unit_bits = sizeof(storage_type) * 8;
+
+  bool reserve(std::size_t n) noexcept;
+  void store(std::uint64_t pos, storage_type value, std::size_t n) noexcept;
+  storage_type load(std::uint64_t pos, std::size_t n) const noexcept;
+  std::atomic<storage_type> &unit(std::uint64_t pos) const noexcept {
+    return units_[(pos / unit_bits) & mask_];
+  }
+
+  std::unique_ptr<std::atomic<storage_type>[]> units_;
+  std::size_t mask_;
+
+  // written by the producer
+  alignas(cache_line_bytes) std::atomic<std::uint64_t> write_pos_{0};
+  // start of the unit holding the read position, as last seen
+  std::uint64_t read_limit_{0};
+  // written by the consumer
+  alignas(cache_line_bytes) std::atomic<std::uint64_t> read_pos_{0};
+  // write position as last seen
+  std::uint64_t write_limit_{0};
+};
+
+} // namespace bitstring
+
+#endif
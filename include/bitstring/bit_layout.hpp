@@ -0,0 +1,199 @@
+#ifndef header_bitstring_bit_layout_hpp
+#define header_bitstring_bit_layout_hpp
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_ops.hpp"
+#include "bitstring/bit_view.hpp"
+#include "bitstring/endian.hpp"
+#include "bitstring/fixed_bit_array.hpp"
+
+namespace bitstring {
+
+namespace detail {
+template <std::size_t N>
+constexpr std::array<std::size_t, N>
+exclusive_prefix_sum(const std::array<std::size_t, N> &v) noexcept {
+  std::array<std::size_t, N> ret{};
+  std::size_t sum = 0;
+  for (std::size_t i = 0; i < N; i++) {
+    ret[i] = sum;
+    sum += v[i];
+  }
+  return ret;
+}
+} // namespace detail
+
+// single field of a bit_layout, Name is any (possibly incomplete) tag type
+template <typename Name, std::size_t Bits,
+          bitorder Order = bitorder::lsb_first>
+struct field {
+  static_assert(Bits > 0 && Bits <= 64, "fields must have 1 to 64 bits");
+  using name = Name;
+  static constexpr std::size_t bits = Bits;
+  static constexpr bitorder order = Order;
+};
+
+#if defined(__cpp_nontype_template_args) &&                                    \
+    __cpp_nontype_template_args >= 201911L
+template <std::size_t L> struct fixed_string {
+  char value[L]{};
+  constexpr fixed_string(const char (&s)[L]) noexcept {
+    for (std::size_t i = 0; i < L; i++) {
+      value[i] = s[i];
+    }
+  }
+};
+
+// tag type for string names, e.g. named_field<"id", 11>
+template <fixed_string S> struct name {};
+template <fixed_string S, std::size_t Bits,
+          bitorder Order = bitorder::lsb_first>
+using named_field = field<name<S>, Bits, Order>;
+#endif
+
+// compile time description of a sequence of bit fields, e.g.
+//
+//   using can_header = bit_layout<field<struct id, 11, bitorder::msb_first>,
+//                                 field<struct rtr, 1>, field<struct ide, 1>,
+//                                 field<struct r0, 1>,
+//                                 field<struct dlc, 4, bitorder::msb_first>>;
+//
+// pack/unpack are generated per layout: adjacent fields are merged into
+// 64 bit accumulators which are written/read in one go
+template <typename... Fields> class bit_layout {
+public:
+  static constexpr std::size_t field_count = sizeof...(Fields);
+  static constexpr std::size_t size = (std::size_t{0} + ... + Fields::bits);
+  using values_type = std::array<std::uint64_t, field_count>;
+
+private:
+  static constexpr std::array<std::size_t, field_count> widths{
+      Fields::bits...};
+  static constexpr std::array<bitorder, field_count> orders{
+      Fields::order...};
+
+  static constexpr std::array<std::size_t, field_count> offsets_{
+      detail::exclusive_prefix_sum(widths)};
+
+  // msb_first fields are stored flipped, which is its own inverse
+  static constexpr std::uint64_t to_stream(std::size_t i,
+                                           std::uint64_t v) noexcept {
+    v &= detail::low_mask<std::uint64_t>(widths[i]);
+    if (orders[i] == bitorder::msb_first) {
+      v = detail::bitflipped(v) >> (64 - widths[i]);
+    }
+    return v;
+  }
+
+public:
+  template <typename Name> static constexpr std::size_t index_of() noexcept {
+    constexpr bool matches[] = {
+        std::is_same<Name, typename Fields::name>::value...};
+    std::size_t idx = field_count;
+    for (std::size_t i = 0; i < field_count; i++) {
+      if (matches[i]) {
+        idx = i;
+      }
+    }
+    return idx;
+  }
+  template <typename Name> static constexpr std::size_t offset_of() noexcept {
+    static_assert(index_of<Name>() < field_count, "no such field");
+    return offsets_[index_of<Name>()];
+  }
+
+  template <typename Name>
+  static constexpr std::uint64_t &get(values_type &values) noexcept {
+    static_assert(index_of<Name>() < field_count, "no such field");
+    return values[index_of<Name>()];
+  }
+  template <typename Name>
+  static constexpr std::uint64_t get(const values_type &values) noexcept {
+    static_assert(index_of<Name>() < field_count, "no such field");
+    return values[index_of<Name>()];
+  }
+
+  // write all fields starting at bit of a raw word buffer (any unsigned word
+  // type, LSB first), bits outside of the layout are not touched
+  template <typename W>
+  static constexpr void pack_into(W *dst, std::size_t bit,
+                                  const values_type &values) noexcept {
+    std::uint64_t acc = 0;
+    std::size_t acc_bits = 0;
+    for (std::size_t i = 0; i < field_count; i++) {
+      const auto v = to_stream(i, values[i]);
+      acc |= acc_bits < 64 ? v << acc_bits : 0;
+      if (acc_bits + widths[i] >= 64) {
+        detail::store_u64(dst, bit, acc, 64);
+        bit += 64;
+        acc = acc_bits == 0 ? 0 : v >> (64 - acc_bits);
+        acc_bits = acc_bits + widths[i] - 64;
+      } else {
+        acc_bits += widths[i];
+      }
+    }
+    detail::store_u64(dst, bit, acc, acc_bits);
+  }
+
+  template <typename W>
+  static constexpr values_type unpack_from(const W *src,
+                                           std::size_t bit) noexcept {
+    values_type ret{};
+    std::uint64_t window = 0;
+    std::size_t window_start = 0;
+    std::size_t window_bits = 0;
+    for (std::size_t i = 0; i < field_count; i++) {
+      if (offsets_[i] + widths[i] > window_start + window_bits) {
+        window_start = offsets_[i];
+        window_bits = size - window_start < 64 ? size - window_start : 64;
+        window = detail::load_u64(src, bit + window_start, window_bits);
+      }
+      const auto shift = offsets_[i] - window_start;
+      ret[i] = to_stream(i, shift < 64 ? window >> shift : 0);
+    }
+    return ret;
+  }
+
+  static constexpr fixed_bit_array<size>
+  pack_fixed(const values_type &values) noexcept {
+    std::array<bit_view::storage_type, fixed_bit_array<size>::units> units{};
+    pack_into(units.data(), 0, values);
+    return fixed_bit_array<size>(bit_view(units.data(), 0, size));
+  }
+
+  static bit_array pack(const values_type &values) {
+    return bit_array(pack_fixed(values).view());
+  }
+
+  static bit_array &append_to(bit_array &ba, const values_type &values) {
+    return ba.append(pack_fixed(values).view());
+  }
+
+  static constexpr values_type unpack(bit_view v) {
+    if (v.size() < size) {
+      throw std::length_error("bit_view is shorter than the layout");
+    }
+    return unpack_from(v.data(), v.offset());
+  }
+
+  template <typename Name> static constexpr std::uint64_t get(bit_view v) {
+    constexpr auto idx = index_of<Name>();
+    static_assert(idx < field_count, "no such field");
+    if (v.size() < size) {
+      throw std::length_error("bit_view is shorter than the layout");
+    }
+    return to_stream(idx, detail::load_u64(v.data(),
+                                           v.offset() + offsets_[idx],
+                                           widths[idx]));
+  }
+};
+
+} // namespace bitstring
+
+#endif
@@ -0,0 +1,320 @@
+#ifndef header_bitstring_bit_ops_hpp
+#define header_bitstring_bit_ops_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+namespace bitstring {
+namespace detail {
+
+// Word level kernels working on bit ranges of an array of storage words.
+// Bit i of a range starting at `bit` is bit (bit + i) % word_bits of word
+// (bit + i) / word_bits, i.e. words are LSB first.
+
+template <typename W>
+constexpr std::size_t word_bits = std::numeric_limits<W>::digits;
+
+template <typename W> constexpr W low_mask(std::size_t n) noexcept {
+  static_assert(std::is_unsigned<W>::value, "storage words must be unsigned");
+  return n >= word_bits<W> ? static_cast<W>(~W{0})
+                           : static_cast<W>((W{1} << n) - 1U);
+}
+
+template <typename W> constexpr unsigned int popcount(W v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (word_bits<W> <= 32) {
+    return static_cast<unsigned int>(__builtin_popcount(v));
+  } else {
+    return static_cast<unsigned int>(__builtin_popcountll(v));
+  }
+#else
+  unsigned int cnt = 0;
+  for (; v != 0; v &= static_cast<W>(v - 1U)) {
+    cnt++;
+  }
+  return cnt;
+#endif
+}
+
+// index of the lowest set bit, v must not be 0
+template <typename W> constexpr unsigned int countr_zero(W v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (word_bits<W> <= 32) {
+    return static_cast<unsigned int>(__builtin_ctz(v));
+  } else {
+    return static_cast<unsigned int>(__builtin_ctzll(v));
+  }
+#else
+  unsigned int cnt = 0;
+  for (; (v & 1U) == 0; v >>= 1U) {
+    cnt++;
+  }
+  return cnt;
+#endif
+}
+
+// number of zero bits above the highest set bit, v must not be 0
+template <typename W> constexpr unsigned int countl_zero(W v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (word_bits<W> <= 32) {
+    return static_cast<unsigned int>(__builtin_clz(v)) -
+           static_cast<unsigned int>(32 - word_bits<W>);
+  } else {
+    return static_cast<unsigned int>(__builtin_clzll(v));
+  }
+#else
+  unsigned int cnt = 0;
+  for (auto bit = W{1} << (word_bits<W> - 1); (v & bit) == 0; bit >>= 1U) {
+    cnt++;
+  }
+  return cnt;
+#endif
+}
+
+// read n <= word_bits bits starting at bit, touches the following word only
+// if the requested bits actually span into it
+template <typename W>
+constexpr W load_bits(const W *src, std::size_t bit, std::size_t n) noexcept {
+  src += bit / word_bits<W>;
+  const auto offset = bit % word_bits<W>;
+  auto v = static_cast<W>(src[0] >> offset);
+  if (offset != 0 && offset + n > word_bits<W>) {
+    v = static_cast<W>(v | (src[1] << (word_bits<W> - offset)));
+  }
+  return static_cast<W>(v & low_mask<W>(n));
+}
+
+// overwrite n <= word_bits bits starting at bit with the low bits of v,
+// all other bits of the destination are preserved
+template <typename W>
+constexpr void store_bits(W *dst, std::size_t bit, W v,
+                          std::size_t n) noexcept {
+  dst += bit / word_bits<W>;
+  const auto offset = bit % word_bits<W>;
+  const auto mask = low_mask<W>(n);
+  v = static_cast<W>(v & mask);
+  dst[0] = static_cast<W>((dst[0] & ~static_cast<W>(mask << offset)) |
+                          static_cast<W>(v << offset));
+  if (offset != 0 && offset + n > word_bits<W>) {
+    const auto rem = offset + n - word_bits<W>;
+    dst[1] = static_cast<W>((dst[1] & ~low_mask<W>(rem)) |
+                            (v >> (word_bits<W> - offset)));
+  }
+}
+
+// copy n bits, ranges must not overlap unless dst_bit <= src_bit
+template <typename W>
+constexpr void copy_bits(W *dst, std::size_t dst_bit, const W *src,
+                         std::size_t src_bit, std::size_t n) noexcept {
+  dst += dst_bit / word_bits<W>;
+  dst_bit %= word_bits<W>;
+  src += src_bit / word_bits<W>;
+  src_bit %= word_bits<W>;
+
+  if (dst_bit != 0 && n != 0) {
+    const auto head =
+        n < word_bits<W> - dst_bit ? n : word_bits<W> - dst_bit;
+    store_bits(dst, dst_bit, load_bits(src, src_bit, head), head);
+    n -= head;
+    dst++;
+    src_bit += head;
+    src += src_bit / word_bits<W>;
+    src_bit %= word_bits<W>;
+  }
+
+  if (src_bit == 0) {
+    for (; n >= word_bits<W>; n -= word_bits<W>) {
+      *dst++ = *src++;
+    }
+  } else {
+    for (; n >= word_bits<W>; n -= word_bits<W>, src++) {
+      *dst++ = static_cast<W>((src[0] >> src_bit) |
+                              (src[1] << (word_bits<W> - src_bit)));
+    }
+  }
+
+  if (n != 0) {
+    store_bits(dst, 0, load_bits(src, src_bit, n), n);
+  }
+}
+
+// set n bits starting at bit to value
+template <typename W>
+constexpr void fill_bits(W *dst, std::size_t bit, bool value,
+                         std::size_t n) noexcept {
+  const auto fill = value ? static_cast<W>(~W{0}) : W{0};
+  dst += bit / word_bits<W>;
+  bit %= word_bits<W>;
+  if (bit != 0 && n != 0) {
+    const auto head = n < word_bits<W> - bit ? n : word_bits<W> - bit;
+    store_bits(dst++, bit, fill, head);
+    n -= head;
+  }
+  for (; n >= word_bits<W>; n -= word_bits<W>) {
+    *dst++ = fill;
+  }
+  if (n != 0) {
+    store_bits(dst, 0, fill, n);
+  }
+}
+
+// load_bits/store_bits for n <= 64 bits, independent of the word size
+template <typename W>
+constexpr std::uint64_t load_u64(const W *src, std::size_t bit,
+                                 std::size_t n) noexcept {
+  std::uint64_t v = 0;
+  for (std::size_t i = 0; i < n; i += word_bits<W>) {
+    const auto cnt = n - i < word_bits<W> ? n - i : word_bits<W>;
+    v |= static_cast<std::uint64_t>(load_bits(src, bit + i, cnt)) << i;
+  }
+  return v;
+}
+
+template <typename W>
+constexpr void store_u64(W *dst, std::size_t bit, std::uint64_t v,
+                         std::size_t n) noexcept {
+  for (std::size_t i = 0; i < n; i += word_bits<W>) {
+    const auto cnt = n - i < word_bits<W> ? n - i : word_bits<W>;
+    store_bits(dst, bit + i, static_cast<W>(v >> i), cnt);
+  }
+}
+
+template <typename W>
+constexpr bool equal_bits(const W *a, std::size_t a_bit, const W *b,
+                          std::size_t b_bit, std::size_t n) noexcept {
+  for (std::size_t i = 0; i < n; i += word_bits<W>) {
+    const auto cnt = n - i < word_bits<W> ? n - i : word_bits<W>;
+    if (load_bits(a, a_bit + i, cnt) != load_bits(b, b_bit + i, cnt)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// number of differing bits
+template <typename W>
+constexpr std::size_t distance_bits(const W *a, std::size_t a_bit, const W *b,
+                                    std::size_t b_bit, std::size_t n) noexcept {
+  std::size_t cnt = 0;
+  for (std::size_t i = 0; i < n; i += 64) {
+    const auto len = n - i < 64 ? n - i : 64;
+    const auto x = load_u64(a, a_bit + i, len) ^ load_u64(b, b_bit + i, len);
+    cnt += popcount(x);
+  }
+  return cnt;
+}
+
+// index of the first differing bit, n if there is none
+template <typename W>
+constexpr std::size_t mismatch_bits(const W *a, std::size_t a_bit,
+                                    const W *b, std::size_t b_bit,
+                                    std::size_t n) noexcept {
+  for (std::size_t i = 0; i < n; i += 64) {
+    const auto len = n - i < 64 ? n - i : 64;
+    const auto x = load_u64(a, a_bit + i, len) ^ load_u64(b, b_bit + i, len);
+    if (x != 0) {
+      return i + countr_zero(x);
+    }
+  }
+  return n;
+}
+
+// lexicographic comparison of n bits in array order (bit 0 first):
+// the lowest set bit of the xor of two words is the first difference
+template <typename W>
+constexpr int compare_bits(const W *a, std::size_t a_bit, const W *b,
+                           std::size_t b_bit, std::size_t n) noexcept {
+  for (std::size_t i = 0; i < n; i += word_bits<W>) {
+    const auto cnt = n - i < word_bits<W> ? n - i : word_bits<W>;
+    const auto x = load_bits(a, a_bit + i, cnt);
+    const auto diff = static_cast<W>(x ^ load_bits(b, b_bit + i, cnt));
+    if (diff != 0) {
+      return ((x >> countr_zero(diff)) & 1U) != 0 ? 1 : -1;
+    }
+  }
+  return 0;
+}
+
+// transpose an 8x8 bit matrix with row i in byte i (bit j = column j):
+// afterwards byte j holds column j
+constexpr std::uint64_t transpose8(std::uint64_t x) noexcept {
+  auto t = (x ^ (x >> 7U)) & 0x00aa00aa00aa00aaULL;
+  x = x ^ t ^ (t << 7U);
+  t = (x ^ (x >> 14U)) & 0x0000cccc0000ccccULL;
+  x = x ^ t ^ (t << 14U);
+  t = (x ^ (x >> 28U)) & 0x00000000f0f0f0f0ULL;
+  return x ^ t ^ (t << 28U);
+}
+
+// gather the bits of x selected by m into the low bits (PEXT), portable
+// version using the parallel suffix method from Hacker's Delight
+inline std::uint64_t pext(std::uint64_t x, std::uint64_t m) noexcept {
+#ifdef __BMI2__
+  return _pext_u64(x, m);
+#else
+  x &= m;
+  auto mk = ~m << 1U;
+  for (unsigned int i = 0; i < 6; i++) {
+    auto mp = mk ^ (mk << 1U);
+    mp ^= mp << 2U;
+    mp ^= mp << 4U;
+    mp ^= mp << 8U;
+    mp ^= mp << 16U;
+    mp ^= mp << 32U;
+    const auto mv = mp & m;
+    m = (m ^ mv) | (mv >> (1U << i));
+    const auto t = x & mv;
+    x = (x ^ t) | (t >> (1U << i));
+    mk &= ~mp;
+  }
+  return x;
+#endif
+}
+
+// scatter the low bits of x to the positions selected by m (PDEP)
+inline std::uint64_t pdep(std::uint64_t x, std::uint64_t m) noexcept {
+#ifdef __BMI2__
+  return _pdep_u64(x, m);
+#else
+  const auto m0 = m;
+  std::uint64_t moves[6] = {};
+  auto mk = ~m << 1U;
+  for (unsigned int i = 0; i < 6; i++) {
+    auto mp = mk ^ (mk << 1U);
+    mp ^= mp << 2U;
+    mp ^= mp << 4U;
+    mp ^= mp << 8U;
+    mp ^= mp << 16U;
+    mp ^= mp << 32U;
+    const auto mv = mp & m;
+    moves[i] = mv;
+    m = (m ^ mv) | (mv >> (1U << i));
+    mk &= ~mp;
+  }
+  for (unsigned int i = 6; i-- > 0;) {
+    x = (x & ~moves[i]) | ((x << (1U << i)) & moves[i]);
+  }
+  return x & m0;
+#endif
+}
+
+// pattern word for a period that divides the word size, e.g. 0b01 -> 0x5555...
+template <typename W>
+constexpr W replicate(W pattern, std::size_t period) noexcept {
+  pattern = static_cast<W>(pattern & low_mask<W>(period));
+  for (auto w = period; w < word_bits<W>; w *= 2) {
+    pattern = static_cast<W>(pattern | (pattern << w));
+  }
+  return pattern;
+}
+
+} // namespace detail
+} // namespace bitstring
+
+#endif
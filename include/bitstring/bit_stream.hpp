@@ -0,0 +1,120 @@
+#ifndef header_bitstring_bit_stream_hpp
+#define header_bitstring_bit_stream_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_ops.hpp"
+#include "bitstring/bit_view.hpp"
+#include "bitstring/exceptions.hpp"
+
+namespace bitstring {
+
+// appends bits to a growing bit sequence, buffering up to one storage unit
+// such that whole units are written to the underlying storage
+class bit_writer {
+public:
+  using storage_type = bit_array::storage_type;
+
+private:
+  static constexpr std::size_t unit_bits = detail::word_bits<storage_type>;
+
+  std::vector<storage_type> units_;
+  std::uint64_t acc_{0};
+  std::size_t acc_bits_{0};
+
+public:
+  bit_writer() = default;
+  explicit bit_writer(std::size_t reserve_bits) {
+    units_.reserve(bit_array::storage_units(reserve_bits));
+  }
+
+  // append the low n <= 64 bits of value, bit 0 first
+  void write(std::uint64_t value, std::size_t n) {
+    if (n > unit_bits) {
+      write_unit(static_cast<storage_type>(value), unit_bits);
+      value >>= unit_bits;
+      n -= unit_bits;
+    }
+    write_unit(static_cast<storage_type>(value), n);
+  }
+
+  void write(bit_view bits) {
+    std::size_t pos = 0;
+    for (; bits.size() - pos >= unit_bits; pos += unit_bits) {
+      write_unit(bits.bits(pos), unit_bits);
+    }
+    if (pos != bits.size()) {
+      write_unit(bits.bits(pos, bits.size() - pos), bits.size() - pos);
+    }
+  }
+
+  std::size_t size() const noexcept {
+    return units_.size() * unit_bits + acc_bits_;
+  }
+
+  // hand out all written bits, the writer is empty afterwards
+  bit_array finish() {
+    const auto bits = size();
+    if (acc_bits_ != 0) {
+      units_.push_back(static_cast<storage_type>(acc_));
+    }
+    acc_ = 0;
+    acc_bits_ = 0;
+    return bit_array(std::exchange(units_, {}), bits);
+  }
+
+private:
+  void write_unit(storage_type value, std::size_t n) {
+    const auto masked = value & detail::low_mask<storage_type>(n);
+    acc_ |= static_cast<std::uint64_t>(masked) << acc_bits_;
+    acc_bits_ += n;
+    if (acc_bits_ >= unit_bits) {
+      units_.push_back(static_cast<storage_type>(acc_));
+      acc_ >>= unit_bits;
+      acc_bits_ -= unit_bits;
+    }
+  }
+};
+
+// consumes bits from the front of a bit sequence, the underlying storage
+// must outlive the reader
+class bit_reader {
+  bit_view bits_;
+  std::size_t pos_{0};
+
+public:
+  explicit bit_reader(bit_view bits) noexcept : bits_(bits) {}
+  // would dangle
+  explicit bit_reader(bit_array &&) = delete;
+
+  std::size_t position() const noexcept { return pos_; }
+  std::size_t remaining() const noexcept { return bits_.size() - pos_; }
+  bool empty() const noexcept { return pos_ == bits_.size(); }
+
+  // the next n <= 64 bits without consuming them, bit 0 first; bits past
+  // the end read as 0
+  std::uint64_t peek(std::size_t n) const noexcept {
+    const auto avail = n < remaining() ? n : remaining();
+    return detail::load_u64(bits_.data(), bits_.offset() + pos_, avail);
+  }
+  // n must be <= remaining()
+  void skip(std::size_t n) noexcept { pos_ += n; }
+
+  // consume n <= 64 bits, decode_error if fewer are left
+  std::uint64_t read(std::size_t n) {
+    if (n > remaining()) {
+      throw decode_error("read past the end of the bit sequence");
+    }
+    const auto v = peek(n);
+    pos_ += n;
+    return v;
+  }
+};
+
+} // namespace bitstring
+
+#endif
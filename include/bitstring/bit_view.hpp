@@ -0,0 +1,115 @@
+#ifndef header_bitstring_bit_view_hpp
+#define header_bitstring_bit_view_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#if __has_include(<compare>)
+#include <compare>
+#endif
+
+#include "bitstring/bit_ops.hpp"
+
+namespace bitstring {
+
+// non-owning, read-only view of a sequence of bits stored in storage units
+// (LSB first), starting at an arbitrary bit offset
+class bit_view {
+public:
+  using storage_type = std::uint32_t;
+  using bitcnt_t = std::size_t;
+
+private:
+  const storage_type *data_{nullptr};
+  std::size_t offset_{0};
+  std::size_t bitcnt_{0};
+
+public:
+  constexpr bit_view() noexcept = default;
+  constexpr bit_view(const storage_type *data, std::size_t offset,
+                     std::size_t bitcnt) noexcept
+      : data_(data + offset / detail::word_bits<storage_type>),
+        offset_(offset % detail::word_bits<storage_type>), bitcnt_(bitcnt) {}
+
+  constexpr std::size_t size() const noexcept { return bitcnt_; }
+  constexpr bool empty() const noexcept { return bitcnt_ == 0; }
+  constexpr const storage_type *data() const noexcept { return data_; }
+  // bit offset of the first bit in data()[0], always < unit size
+  constexpr std::size_t offset() const noexcept { return offset_; }
+
+  constexpr uint8_t operator[](bitcnt_t idx) const noexcept {
+    return static_cast<uint8_t>(detail::load_bits(data_, offset_ + idx, 1));
+  }
+
+  // up to one storage unit worth of bits, starting at idx
+  constexpr storage_type
+  bits(bitcnt_t idx,
+       std::size_t n = detail::word_bits<storage_type>) const noexcept {
+    return detail::load_bits(data_, offset_ + idx, n);
+  }
+
+  constexpr bit_view subview(bitcnt_t pos, bitcnt_t len) const {
+    if (pos > bitcnt_ || len > bitcnt_ - pos) {
+      throw std::out_of_range("subview exceeds bit_view");
+    }
+    return bit_view(data_, offset_ + pos, len);
+  }
+
+  std::string bin() const {
+    auto ret = std::string(bitcnt_, '0');
+    for (bitcnt_t i = 0; i < bitcnt_; i++) {
+      if ((*this)[i] != 0) {
+        ret[i] = '1';
+      }
+    }
+    return ret;
+  }
+};
+
+constexpr bool operator==(bit_view a, bit_view b) noexcept {
+  return a.size() == b.size() &&
+         detail::equal_bits(a.data(), a.offset(), b.data(), b.offset(),
+                            a.size());
+}
+
+constexpr bool operator!=(bit_view a, bit_view b) noexcept {
+  return !(a == b);
+}
+
+// lexicographic order in array order, a proper prefix orders first;
+// returns <0, 0 or >0 like std::string::compare
+constexpr int compare(bit_view a, bit_view b) noexcept {
+  const auto n = a.size() < b.size() ? a.size() : b.size();
+  const auto cmp =
+      detail::compare_bits(a.data(), a.offset(), b.data(), b.offset(), n);
+  if (cmp != 0) {
+    return cmp;
+  }
+  return a.size() < b.size() ? -1 : (a.size() > b.size() ? 1 : 0);
+}
+
+constexpr bool operator<(bit_view a, bit_view b) noexcept {
+  return compare(a, b) < 0;
+}
+constexpr bool operator>(bit_view a, bit_view b) noexcept {
+  return compare(a, b) > 0;
+}
+constexpr bool operator<=(bit_view a, bit_view b) noexcept {
+  return compare(a, b) <= 0;
+}
+constexpr bool operator>=(bit_view a, bit_view b) noexcept {
+  return compare(a, b) >= 0;
+}
+
+#if defined(__cpp_impl_three_way_comparison) &&                               \
+    defined(__cpp_lib_three_way_comparison)
+constexpr std::strong_ordering operator<=>(bit_view a,
+                                           bit_view b) noexcept {
+  return compare(a, b) <=> 0;
+}
+#endif
+
+} // namespace bitstring
+
+#endif
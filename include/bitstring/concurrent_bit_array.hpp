@@ -0,0 +1,94 @@
+#ifndef header_bitstring_concurrent_bit_array_hpp
+#define header_bitstring_concurrent_bit_array_hpp
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "bitstring/algorithm.hpp"
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_view.hpp"
+
+namespace bitstring {
+
+// Fixed size bit set that can be modified by many threads at once, e.g. as
+// an allocation bitmap. Every operation is lock-free and atomic per storage
+// unit; operations spanning several units (fetch_or, count, snapshot) are
+// not atomic as a whole.
+//
+// Storage is grouped into cache line aligned blocks. Threads that claim
+// bits should start at different hints (see spread_hint) so that they work
+// on separate cache lines until the set fills up.
+class concurrent_bit_array {
+public:
+  using storage_type = bit_view::storage_type;
+  using bitcnt_t = std::size_t;
+
+  static constexpr std::size_t cache_line_bytes = 64;
+
+  explicit concurrent_bit_array(bitcnt_t size);
+
+  bitcnt_t size() const noexcept { return bitcnt_; }
+
+  // idx must be < size(); the modifying operations return the previous
+  // value of the bit and order memory like acquiring/releasing a lock
+  bool test(bitcnt_t idx) const noexcept {
+    return (unit(idx / unit_bits).load(std::memory_order_acquire) &
+            bit(idx)) != 0;
+  }
+  bool test_and_set(bitcnt_t idx) noexcept {
+    return (unit(idx / unit_bits).fetch_or(bit(idx),
+                                           std::memory_order_acq_rel) &
+            bit(idx)) != 0;
+  }
+  bool reset(bitcnt_t idx) noexcept {
+    return (unit(idx / unit_bits).fetch_and(~bit(idx),
+                                            std::memory_order_acq_rel) &
+            bit(idx)) != 0;
+  }
+
+  // or bits into [pos, pos + bits.size()), std::out_of_range if the range
+  // exceeds the array
+  void fetch_or(bitcnt_t pos, bit_view bits);
+
+  // number of set bits, relaxed: concurrent modifications may or may not
+  // be observed
+  bitcnt_t count() const noexcept;
+
+  // atomically set a bit that was unset and return its index, npos if all
+  // bits are set. The search starts at hint and wraps around.
+  bitcnt_t claim(bitcnt_t hint = 0) noexcept;
+
+  // start position for slot out of slots claimers, spreading them evenly
+  // over the array on cache line boundaries
+  bitcnt_t spread_hint(std::size_t slot, std::size_t slots) const noexcept;
+
+  // copy of the current contents, relaxed like count()
+  bit_array snapshot() const;
+
+private:
+  static constexpr std::size_t unit_bits = sizeof(storage_type) * 8;
+  static constexpr std::size_t line_units =
+      cache_line_bytes / sizeof(storage_type);
+
+  struct alignas(cache_line_bytes) line {
+    std::atomic<storage_type> units[line_units];
+  };
+
+  static storage_type bit(bitcnt_t idx) noexcept {
+    return storage_type{1} << (idx % unit_bits);
+  }
+  std::atomic<storage_type> &unit(std::size_t i) const noexcept {
+    return lines_[i / line_units].units[i % line_units];
+  }
+  std::size_t unit_count() const noexcept {
+    return (bitcnt_ + unit_bits - 1) / unit_bits;
+  }
+
+  bitcnt_t bitcnt_;
+  std::unique_ptr<line[]> lines_;
+};
+
+} // namespace bitstring
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef header_bitstring_crc_hpp
+#define header_bitstring_crc_hpp
+
+#include <array>
+#include <cstdint>
+
+#include "bitstring/bit_view.hpp"
+
+namespace bitstring {
+
+// CRC parameters following the Rocksoft model / CRC catalogue, with
+// the polynomial in normal (MSB first) notation and width <= 64.
+//
+// The CRC is computed over the bits in array order, i.e. the bit_array is
+// the serialized bit stream. For that reason there is no reflect-in
+// parameter: input reflection only describes how bytes are serialized.
+// Arrays built from bytes LSB first (bit_array(std::vector<uint8_t>))
+// reproduce the catalogue check values of refin=true algorithms, arrays
+// built MSB first (bit_array(byte, bitorder::msb_first)) those of
+// refin=false algorithms, like a CAN frame in transmission order does.
+struct crc_params {
+  unsigned int width;
+  std::uint64_t poly;
+  std::uint64_t init;
+  bool refout;
+  std::uint64_t xorout;
+};
+
+namespace crc_catalog {
+// refin=false in the catalogue
+inline constexpr crc_params crc15_can{15, 0x4599, 0, false, 0};
+inline constexpr crc_params crc16_ccitt_false{16, 0x1021, 0xffff, false, 0};
+// refin=true in the catalogue
+inline constexpr crc_params crc16_kermit{16, 0x1021, 0, true, 0};
+inline constexpr crc_params crc32{32, 0x04c11db7, 0xffffffff, true,
+                                  0xffffffff};
+} // namespace crc_catalog
+
+// table driven CRC engine, consumes 32 bits per step (slice-by-4) at
+// arbitrary bit offsets; the tables are built once per engine
+class crc_engine {
+public:
+  explicit crc_engine(const crc_params &params);
+
+  crc_engine &update(bit_view bits) noexcept;
+  crc_engine &reset() noexcept;
+  // final CRC of all bits passed to update since the last reset
+  std::uint64_t value() const noexcept;
+
+  std::uint64_t operator()(bit_view bits) noexcept {
+    return reset().update(bits).value();
+  }
+
+private:
+  crc_params params_;
+  std::uint64_t rpoly_;
+  // register is kept reflected (LSB is the oldest bit), which matches the
+  // LSB first storage and makes shifts go away from the data
+  std::uint64_t reg_;
+  std::array<std::array<std::uint64_t, 256>, 4> table_;
+};
+
+std::uint64_t crc(const crc_params &params, bit_view bits);
+
+} // namespace bitstring
+
+#endif
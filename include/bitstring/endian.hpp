@@ -31,11 +31,24 @@ template <> constexpr uint8_t bitflipped<uint8_t>(uint8_t v) noexcept {
   return v;
 }
 
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_bitreverse32)
+// single instruction on targets that have one (e.g. rbit on ARM)
+template <> constexpr uint32_t bitflipped<uint32_t>(uint32_t v) noexcept {
+  return __builtin_bitreverse32(v);
+}
+#endif
+#endif
+
 template <typename T> constexpr T bitflipped(T v) noexcept {
   constexpr auto shift_width = 8 * sizeof(half_type_t<T>);
-  const T flipped_upper = bitflipped<half_type_t<T>>(v >> shift_width);
-  const T flipped_lower = bitflipped<half_type_t<T>>(v);
-  return (flipped_lower << shift_width) | flipped_upper;
+  using half_t = half_type_t<T>;
+  const T flipped_upper =
+      bitflipped<half_t>(static_cast<half_t>(v >> shift_width));
+  T flipped = bitflipped<half_t>(static_cast<half_t>(v));
+  flipped <<= shift_width;
+  flipped |= flipped_upper;
+  return flipped;
 }
 } // namespace detail
 } // namespace bitstring
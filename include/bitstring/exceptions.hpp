@@ -9,6 +9,10 @@ class parse_error : public std::runtime_error {
   using runtime_error::runtime_error;
 };
 
+class decode_error : public std::runtime_error {
+  using runtime_error::runtime_error;
+};
+
 } // namespace bitstring
 
 #endif
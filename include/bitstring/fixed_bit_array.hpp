@@ -0,0 +1,231 @@
+#ifndef header_bitstring_fixed_bit_array_hpp
+#define header_bitstring_fixed_bit_array_hpp
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_ops.hpp"
+#include "bitstring/bit_view.hpp"
+#include "bitstring/endian.hpp"
+
+namespace bitstring {
+
+// bit sequence with a length fixed at compile time, usable in constant
+// expressions (e.g. protocol headers or masks); storage layout is the same
+// as for bit_array, with offset 0 and padding bits kept at 0
+template <std::size_t N> class fixed_bit_array {
+public:
+  using storage_type = bit_array::storage_type;
+  using bitcnt_t = std::size_t;
+  static constexpr std::size_t units =
+      (N + detail::word_bits<storage_type> - 1) /
+      detail::word_bits<storage_type>;
+
+private:
+  std::array<storage_type, units> bits_{};
+
+public:
+  constexpr fixed_bit_array() noexcept = default;
+  template <typename T,
+            typename std::enable_if<std::is_integral<T>::value &&
+                                        std::is_unsigned<T>::value &&
+                                        !std::is_same<T, bool>::value,
+                                    int>::type = 0>
+  constexpr explicit fixed_bit_array(T v,
+                                     bitorder bio = bitorder::lsb_first) noexcept
+      : bits_{} {
+    static_assert(N <= 64, "integer initialization is limited to 64 bits");
+    auto value = static_cast<std::uint64_t>(v);
+    if (N == 0) {
+      return;
+    }
+    if (bio == bitorder::msb_first) {
+      value = detail::bitflipped(value) >> (64 - N);
+    }
+    for (std::size_t i = 0; i < units; i++) {
+      bits_[i] = static_cast<storage_type>(
+          value >> (i * detail::word_bits<storage_type>));
+    }
+    clear_padding();
+  }
+  constexpr explicit fixed_bit_array(bit_view v) : bits_{} {
+    if (v.size() != N) {
+      throw std::length_error("bit_view size does not match fixed_bit_array");
+    }
+    detail::copy_bits(bits_.data(), 0, v.data(), v.offset(), N);
+  }
+
+  constexpr std::size_t size() const noexcept { return N; }
+  constexpr bool empty() const noexcept { return N == 0; }
+
+  constexpr uint8_t operator[](bitcnt_t idx) const noexcept {
+    return static_cast<uint8_t>(detail::load_bits(bits_.data(), idx, 1));
+  }
+  constexpr fixed_bit_array &set(bitcnt_t idx, bool value = true) noexcept {
+    detail::store_bits(bits_.data(), idx, static_cast<storage_type>(value), 1);
+    return *this;
+  }
+  constexpr fixed_bit_array &reset(bitcnt_t idx) noexcept {
+    return set(idx, false);
+  }
+
+  constexpr fixed_bit_array &operator&=(const fixed_bit_array &o) noexcept {
+    for (std::size_t i = 0; i < units; i++) {
+      bits_[i] &= o.bits_[i];
+    }
+    return *this;
+  }
+  constexpr fixed_bit_array &operator|=(const fixed_bit_array &o) noexcept {
+    for (std::size_t i = 0; i < units; i++) {
+      bits_[i] |= o.bits_[i];
+    }
+    return *this;
+  }
+  constexpr fixed_bit_array &operator^=(const fixed_bit_array &o) noexcept {
+    for (std::size_t i = 0; i < units; i++) {
+      bits_[i] ^= o.bits_[i];
+    }
+    return *this;
+  }
+  constexpr fixed_bit_array operator~() const noexcept {
+    auto ret = *this;
+    for (auto &unit : ret.bits_) {
+      unit = static_cast<storage_type>(~unit);
+    }
+    ret.clear_padding();
+    return ret;
+  }
+
+  constexpr bool operator==(const fixed_bit_array &o) const noexcept {
+    for (std::size_t i = 0; i < units; i++) {
+      if (bits_[i] != o.bits_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+  constexpr bool operator!=(const fixed_bit_array &o) const noexcept {
+    return !(*this == o);
+  }
+
+  constexpr bit_view view() const noexcept {
+    return bit_view(bits_.data(), 0, N);
+  }
+  constexpr operator bit_view() const noexcept { return view(); }
+  bit_array to_bit_array() const { return bit_array(view()); }
+  std::string bin() const { return view().bin(); }
+
+  constexpr const std::array<storage_type, units> &data() const noexcept {
+    return bits_;
+  }
+
+  template <std::size_t M>
+  constexpr fixed_bit_array<N + M>
+  operator+(const fixed_bit_array<M> &o) const noexcept {
+    fixed_bit_array<N + M> ret;
+    ret.assign(0, view());
+    ret.assign(N, o.view());
+    return ret;
+  }
+
+  // overwrite size() bits starting at pos, for composing constants
+  constexpr fixed_bit_array &assign(bitcnt_t pos, bit_view v) {
+    if (pos > N || v.size() > N - pos) {
+      throw std::out_of_range("assignment exceeds fixed_bit_array");
+    }
+    detail::copy_bits(bits_.data(), pos, v.data(), v.offset(), v.size());
+    return *this;
+  }
+
+private:
+  constexpr void clear_padding() noexcept {
+    if (N % detail::word_bits<storage_type> != 0) {
+      bits_[units - 1] &= detail::low_mask<storage_type>(
+          N % detail::word_bits<storage_type>);
+    }
+  }
+};
+
+template <std::size_t N>
+constexpr fixed_bit_array<N> operator&(fixed_bit_array<N> a,
+                                       const fixed_bit_array<N> &b) noexcept {
+  return a &= b;
+}
+template <std::size_t N>
+constexpr fixed_bit_array<N> operator|(fixed_bit_array<N> a,
+                                       const fixed_bit_array<N> &b) noexcept {
+  return a |= b;
+}
+template <std::size_t N>
+constexpr fixed_bit_array<N> operator^(fixed_bit_array<N> a,
+                                       const fixed_bit_array<N> &b) noexcept {
+  return a ^= b;
+}
+
+namespace detail {
+constexpr bool is_separator(char c) noexcept { return c == '\'' || c == '_'; }
+
+template <char... Cs> constexpr unsigned int literal_digit_bits() noexcept {
+  constexpr char chars[] = {Cs...};
+  if (sizeof...(Cs) > 2 && chars[0] == '0') {
+    if (chars[1] == 'b' || chars[1] == 'B') {
+      return 1;
+    }
+    if (chars[1] == 'x' || chars[1] == 'X') {
+      return 4;
+    }
+  }
+  return 0;
+}
+
+template <char... Cs> constexpr std::size_t literal_bits() noexcept {
+  constexpr char chars[] = {Cs...};
+  std::size_t cnt = 0;
+  for (std::size_t i = 2; i < sizeof...(Cs); i++) {
+    if (!is_separator(chars[i])) {
+      cnt += literal_digit_bits<Cs...>();
+    }
+  }
+  return cnt;
+}
+
+constexpr unsigned int hex_digit_value(char c) noexcept {
+  if (c >= 'a' && c <= 'f') {
+    return static_cast<unsigned int>(c - 'a' + 10);
+  }
+  if (c >= 'A' && c <= 'F') {
+    return static_cast<unsigned int>(c - 'A' + 10);
+  }
+  return static_cast<unsigned int>(c - '0');
+}
+
+// digits are taken in order, each MSB first, like the _ba literal
+template <char... Cs>
+constexpr fixed_bit_array<literal_bits<Cs...>()> parse_fixed_literal() {
+  constexpr char chars[] = {Cs...};
+  constexpr auto digit_bits = literal_digit_bits<Cs...>();
+  static_assert(digit_bits != 0,
+                "only binary (0b...) and hex (0x...) literals are supported");
+  fixed_bit_array<literal_bits<Cs...>()> ret;
+  std::size_t idx = 0;
+  for (std::size_t i = 2; i < sizeof...(Cs); i++) {
+    if (is_separator(chars[i])) {
+      continue;
+    }
+    const auto v = hex_digit_value(chars[i]);
+    for (unsigned int b = digit_bits; b-- > 0;) {
+      ret.set(idx++, ((v >> b) & 1U) != 0);
+    }
+  }
+  return ret;
+}
+} // namespace detail
+
+} // namespace bitstring
+
+#endif
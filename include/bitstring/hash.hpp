@@ -0,0 +1,55 @@
+#ifndef header_bitstring_hash_hpp
+#define header_bitstring_hash_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_view.hpp"
+
+namespace bitstring {
+
+// Streaming 64 bit hash over a bit sequence, wyhash style: 128 bit blocks
+// are folded into the state with a 64x64->128 bit multiply. Input is
+// realigned to 64 bit words, so the result only depends on the bits and
+// their number, not on storage offsets or on how the input is split
+// across update calls. Not suitable for cryptographic purposes.
+class bit_hasher {
+public:
+  explicit bit_hasher(std::uint64_t seed = 0) noexcept { reset(seed); }
+
+  bit_hasher &update(bit_view bits) noexcept;
+  bit_hasher &reset(std::uint64_t seed = 0) noexcept;
+  std::uint64_t digest() const noexcept;
+
+private:
+  void push(std::uint64_t word) noexcept;
+
+  std::uint64_t state_;
+  std::uint64_t pending_;
+  bool has_pending_;
+  std::uint64_t acc_;
+  std::size_t acc_bits_;
+  std::uint64_t bitcnt_;
+};
+
+std::uint64_t hash(bit_view bits, std::uint64_t seed = 0) noexcept;
+
+} // namespace bitstring
+
+namespace std {
+template <> struct hash<bitstring::bit_view> {
+  std::size_t operator()(bitstring::bit_view bits) const noexcept {
+    return bitstring::hash(bits);
+  }
+};
+
+template <> struct hash<bitstring::bit_array> {
+  std::size_t operator()(const bitstring::bit_array &bits) const noexcept {
+    return bitstring::hash(bits);
+  }
+};
+} // namespace std
+
+#endif
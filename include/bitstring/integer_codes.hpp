@@ -0,0 +1,49 @@
+#ifndef header_bitstring_integer_codes_hpp
+#define header_bitstring_integer_codes_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_stream.hpp"
+#include "bitstring/bit_view.hpp"
+
+namespace bitstring {
+
+// Variable length codes for unsigned integers. Unary prefixes are zeros
+// terminated by a one and binary parts are sent MSB first, as in video
+// bitstreams:
+//   exp_golomb   order k (ue(v) for k = 0): v + 2^k in binary, preceded by
+//                one zero per bit beyond k + 1
+//   elias_gamma  v >= 1: exp_golomb of v - 1
+//   elias_delta  v >= 1: elias_gamma of the bit width n of v, followed by
+//                the low n - 1 bits of v
+//   rice         parameter k: v >> k in unary, followed by the low k bits
+//   leb128       groups of 7 bits, low group first, in bytes sent LSB
+//                first with bit 7 set on all but the last byte
+enum class integer_code { exp_golomb, elias_gamma, elias_delta, rice, leb128 };
+
+// k is the order of exp_golomb or the parameter of rice (< 64), ignored by
+// the other codes. Encoding throws std::out_of_range for values the code
+// cannot represent (0 for elias codes, v >= 2^64 - 2^k for exp_golomb).
+void encode_integer(bit_writer &out, std::uint64_t v, integer_code code,
+                    std::size_t k = 0);
+// decode_error on truncated input or values exceeding 64 bits
+std::uint64_t decode_integer(bit_reader &in, integer_code code,
+                             std::size_t k = 0);
+// decode up to count values into out, stopping early at the end of the
+// input; returns the number of values decoded
+std::size_t decode_integers(bit_reader &in, std::uint64_t *out,
+                            std::size_t count, integer_code code,
+                            std::size_t k = 0);
+
+bit_array encode_integers(const std::vector<std::uint64_t> &values,
+                          integer_code code, std::size_t k = 0);
+// decode all of bits, which must end with a complete value
+std::vector<std::uint64_t> decode_integers(bit_view bits, integer_code code,
+                                           std::size_t k = 0);
+
+} // namespace bitstring
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef header_bitstring_interleave_hpp
+#define header_bitstring_interleave_hpp
+
+#include <cstddef>
+#include <vector>
+
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_view.hpp"
+
+namespace bitstring {
+
+// Split a capture of `lanes` parallel lines into one bit_array per line:
+// bit t * lanes + l of source is bit t of lane l. Any lane count is
+// supported, blocks of 8 samples x 8 lanes are transposed at once.
+// Throws std::invalid_argument if lanes is 0 or does not divide the size.
+std::vector<bit_array> deinterleave(bit_view source, std::size_t lanes);
+
+// inverse of deinterleave, all lanes must have the same size
+// (std::invalid_argument otherwise)
+bit_array interleave(const std::vector<bit_view> &lanes);
+bit_array interleave(const std::vector<bit_array> &lanes);
+
+} // namespace bitstring
+
+#endif
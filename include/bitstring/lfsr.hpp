@@ -0,0 +1,50 @@
+#ifndef header_bitstring_lfsr_hpp
+#define header_bitstring_lfsr_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_view.hpp"
+
+namespace bitstring {
+
+// Fibonacci LFSR generating s[k] = XOR of s[k - t] for every tap t.
+// Taps are given as mask with bit t-1 set for tap t, the degree of the
+// generator is the highest tap (<= 63). As all taps are at least
+// min(taps) bits back, that many bits are produced per step.
+class lfsr {
+public:
+  // state holds the previous degree bits, the oldest one in bit 0
+  lfsr(std::uint64_t taps, std::uint64_t state);
+
+  bit_array generate(std::size_t bits);
+  // additive scrambling: XOR the generated sequence onto the data,
+  // applying it again with the same initial state descrambles
+  bit_array scramble(bit_view data);
+
+  std::uint64_t state() const noexcept { return state_; }
+  unsigned int degree() const noexcept { return degree_; }
+
+private:
+  bit_array::storage_type next_bits(std::size_t n) noexcept;
+  void refill() noexcept;
+
+  std::vector<unsigned int> taps_;
+  unsigned int degree_;
+  unsigned int step_;
+  std::uint64_t state_;
+  std::uint64_t pending_{0};
+  std::size_t pending_bits_{0};
+};
+
+// ITU-T O.150 style PRBS generators x^7+x^6+1, x^15+x^14+1, x^31+x^28+1,
+// seeded with all ones by default
+lfsr prbs7(std::uint64_t state = 0x7f);
+lfsr prbs15(std::uint64_t state = 0x7fff);
+lfsr prbs31(std::uint64_t state = 0x7fffffff);
+
+} // namespace bitstring
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef header_bitstring_line_coding_hpp
+#define header_bitstring_line_coding_hpp
+
+#include <cstdint>
+
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_stream.hpp"
+#include "bitstring/bit_view.hpp"
+
+namespace bitstring {
+
+// hdlc: a 0 is inserted after five consecutive 1s
+// can: the complement is inserted after five equal bits, stuff bits count
+//      towards the next run
+enum class stuffing { hdlc, can };
+
+// Stuffers keep their state between calls, such that a stream can be
+// passed in chunks. Input is processed a byte at a time using tables.
+class stuffer {
+public:
+  explicit stuffer(stuffing mode = stuffing::hdlc) noexcept : mode_(mode) {}
+  void operator()(bit_view in, bit_writer &out);
+
+private:
+  stuffing mode_;
+  std::uint8_t state_{0};
+};
+
+// throws decode_error if a stuff bit has the wrong value
+class unstuffer {
+public:
+  explicit unstuffer(stuffing mode = stuffing::hdlc) noexcept : mode_(mode) {}
+  void operator()(bit_view in, bit_writer &out);
+
+private:
+  stuffing mode_;
+  std::uint8_t state_{0};
+};
+
+bit_array stuff(bit_view in, stuffing mode = stuffing::hdlc);
+bit_array unstuff(bit_view in, stuffing mode = stuffing::hdlc);
+
+// ieee_802_3: 0 is sent as 10, 1 as 01
+// thomas: 1 is sent as 10, 0 as 01
+enum class manchester { ieee_802_3, thomas };
+
+void manchester_encode(bit_view in, bit_writer &out,
+                       manchester convention = manchester::ieee_802_3);
+// throws decode_error on odd input length or a pair without transition
+void manchester_decode(bit_view in, bit_writer &out,
+                       manchester convention = manchester::ieee_802_3);
+bit_array manchester_encode(bit_view in,
+                            manchester convention = manchester::ieee_802_3);
+bit_array manchester_decode(bit_view in,
+                            manchester convention = manchester::ieee_802_3);
+
+// transition_on_zero: USB style NRZI, transition_on_one: NRZ-M
+enum class nrzi { transition_on_zero, transition_on_one };
+
+// level is the line level before the first bit and is updated to the level
+// after the last bit, making chunked operation possible
+class nrzi_encoder {
+public:
+  explicit nrzi_encoder(nrzi mode = nrzi::transition_on_zero,
+                        bool level = false) noexcept
+      : mode_(mode), level_(level) {}
+  void operator()(bit_view in, bit_writer &out);
+  bool level() const noexcept { return level_; }
+
+private:
+  nrzi mode_;
+  bool level_;
+};
+
+class nrzi_decoder {
+public:
+  explicit nrzi_decoder(nrzi mode = nrzi::transition_on_zero,
+                        bool level = false) noexcept
+      : mode_(mode), level_(level) {}
+  void operator()(bit_view in, bit_writer &out);
+  bool level() const noexcept { return level_; }
+
+private:
+  nrzi mode_;
+  bool level_;
+};
+
+bit_array nrzi_encode(bit_view in, nrzi mode = nrzi::transition_on_zero,
+                      bool level = false);
+bit_array nrzi_decode(bit_view in, nrzi mode = nrzi::transition_on_zero,
+                      bool level = false);
+
+} // namespace bitstring
+
+#endif
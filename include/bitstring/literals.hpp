@@ -2,11 +2,19 @@
 #define header_bitstring_literals_hpp
 
 #include "bitstring/bit_array.hpp"
+#include "bitstring/fixed_bit_array.hpp"
 
 namespace bitstring::literals {
 
 bitstring::bit_array operator"" _ba(const char *, std::size_t);
 
+// compile time variant of _ba: 0b1101_fba is a fixed_bit_array<4> with the
+// bits in the same order as "0b1101"_ba, 0x3f_fba one with 8 bits like
+// "0x3f"_ba
+template <char... Cs> constexpr auto operator"" _fba() {
+  return bitstring::detail::parse_fixed_literal<Cs...>();
 }
 
+} // namespace bitstring::literals
+
 #endif
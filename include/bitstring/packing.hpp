@@ -0,0 +1,46 @@
+#ifndef header_bitstring_packing_hpp
+#define header_bitstring_packing_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_view.hpp"
+#include "bitstring/endian.hpp"
+
+namespace bitstring {
+
+// Fixed width bit packing of integer arrays: value i occupies bits
+// [i * width, (i + 1) * width), only the low width bits of each value are
+// stored. With msb_first the bits of each value are in reverse order, like
+// the integer constructor of bit_array.
+//
+// Every width has its own kernel, so shifts and masks are compile time
+// constants. T must be one of the fixed width unsigned types and width
+// 1 to 8 * sizeof(T), std::invalid_argument otherwise.
+template <typename T>
+bit_array pack(const T *values, std::size_t count, std::size_t width,
+               bitorder bio = bitorder::lsb_first);
+template <typename T>
+bit_array pack(const std::vector<T> &values, std::size_t width,
+               bitorder bio = bitorder::lsb_first) {
+  return pack(values.data(), values.size(), width, bio);
+}
+
+// writes bits.size() / width values to out; the size must be a multiple of
+// width (std::invalid_argument otherwise)
+template <typename T>
+void unpack(bit_view bits, std::size_t width, T *out,
+            bitorder bio = bitorder::lsb_first);
+template <typename T>
+std::vector<T> unpack(bit_view bits, std::size_t width,
+                      bitorder bio = bitorder::lsb_first) {
+  std::vector<T> ret(width == 0 ? 0 : bits.size() / width);
+  unpack(bits, width, ret.data(), bio);
+  return ret;
+}
+
+} // namespace bitstring
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef header_bitstring_prefix_code_hpp
+#define header_bitstring_prefix_code_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_stream.hpp"
+#include "bitstring/bit_view.hpp"
+
+namespace bitstring {
+
+// Decoder for prefix (e.g. Huffman) codes. The codewords are compiled into
+// multi-level lookup tables: every lookup resolves up to root_bits of
+// input, longer codewords continue in a subtable selected by the first
+// root_bits bits. Codewords are matched in array order, bit 0 first.
+class prefix_code {
+public:
+  using symbol_type = std::uint32_t;
+
+  // std::invalid_argument if a codeword is empty, longer than 64 bits or
+  // the prefix of another one; root_bits must be 1 to 16
+  explicit prefix_code(
+      const std::vector<std::pair<bit_array, symbol_type>> &codes,
+      std::size_t root_bits = 12);
+
+  // decode_error on bits that start no codeword or a truncated codeword
+  symbol_type decode(bit_reader &reader) const;
+  // decode up to count symbols into out, stopping early at the end of the
+  // input; returns the number of symbols decoded
+  std::size_t decode(bit_reader &reader, symbol_type *out,
+                     std::size_t count) const;
+  // decode all of bits, which must end with a complete codeword
+  std::vector<symbol_type> decode(bit_view bits) const;
+
+private:
+  enum class kind : std::uint8_t { invalid, symbol, table };
+  struct entry {
+    // symbol, or start of the subtable in entries_
+    std::uint32_t value;
+    // bits of the codeword at this level, or index bits of the subtable
+    std::uint8_t bits;
+    kind type;
+  };
+  struct codeword {
+    std::uint64_t bits;
+    std::size_t length;
+    symbol_type symbol;
+  };
+
+  std::size_t table_bits(const std::vector<codeword> &codes) const noexcept;
+  std::size_t build(const std::vector<codeword> &codes);
+
+  std::size_t root_bits_;
+  // index bits of the root table
+  std::size_t first_bits_{0};
+  std::vector<entry> entries_;
+};
+
+} // namespace bitstring
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef header_bitstring_run_bit_array_hpp
+#define header_bitstring_run_bit_array_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_view.hpp"
+
+namespace bitstring {
+
+// Run-length compressed bit sequence for long runs of equal bits, e.g. idle
+// lines. Runs alternate in value, so only the value of the first run and
+// the (exclusive) end position of every run are stored.
+//
+// The representation is canonical (no empty runs, neighbouring runs differ)
+// which makes equality a plain comparison of the run ends.
+class run_bit_array {
+public:
+  using bitcnt_t = std::size_t;
+
+  struct run {
+    bitcnt_t pos;
+    bitcnt_t length;
+    bool value;
+  };
+
+  class run_iterator {
+    const bitcnt_t *end_;
+    bitcnt_t pos_;
+    bool value_;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = run;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = run;
+
+    run_iterator(const bitcnt_t *end, bitcnt_t pos, bool value) noexcept
+        : end_(end), pos_(pos), value_(value) {}
+
+    run operator*() const noexcept { return {pos_, *end_ - pos_, value_}; }
+    run_iterator &operator++() noexcept {
+      pos_ = *end_++;
+      value_ = !value_;
+      return *this;
+    }
+    run_iterator operator++(int) noexcept {
+      auto ret = *this;
+      ++*this;
+      return ret;
+    }
+    bool operator==(const run_iterator &o) const noexcept {
+      return end_ == o.end_;
+    }
+    bool operator!=(const run_iterator &o) const noexcept {
+      return end_ != o.end_;
+    }
+  };
+
+  class run_range {
+    run_iterator begin_;
+    run_iterator end_;
+
+  public:
+    run_range(run_iterator b, run_iterator e) noexcept : begin_(b), end_(e) {}
+    run_iterator begin() const noexcept { return begin_; }
+    run_iterator end() const noexcept { return end_; }
+  };
+
+private:
+  bool first_{false};
+  std::vector<bitcnt_t> ends_;
+
+public:
+  run_bit_array() = default;
+  explicit run_bit_array(bit_view bits);
+
+  bit_array to_bit_array() const;
+
+  bitcnt_t size() const noexcept { return ends_.empty() ? 0 : ends_.back(); }
+  bool empty() const noexcept { return ends_.empty(); }
+  std::size_t run_count() const noexcept { return ends_.size(); }
+  run_range runs() const noexcept {
+    return {run_iterator(ends_.data(), 0, first_),
+            run_iterator(ends_.data() + ends_.size(), size(), first_)};
+  }
+
+  // O(log(runs)), idx must be < size()
+  uint8_t operator[](bitcnt_t idx) const noexcept;
+  // number of set bits
+  bitcnt_t count() const noexcept;
+
+  // append n bits of the given value
+  run_bit_array &append(bool value, bitcnt_t n = 1);
+
+  // operands must have the same size, throws std::length_error otherwise
+  run_bit_array &operator&=(const run_bit_array &o);
+  run_bit_array &operator|=(const run_bit_array &o);
+  run_bit_array &operator^=(const run_bit_array &o);
+  run_bit_array operator~() const;
+
+  bool operator==(const run_bit_array &o) const noexcept {
+    return first_ == o.first_ && ends_ == o.ends_;
+  }
+  bool operator!=(const run_bit_array &o) const noexcept {
+    return !(*this == o);
+  }
+
+private:
+  bool run_value(std::size_t i) const noexcept {
+    return first_ != ((i & 1U) != 0);
+  }
+  template <typename Op>
+  static run_bit_array combine(const run_bit_array &a, const run_bit_array &b,
+                               Op op);
+};
+
+inline run_bit_array operator&(run_bit_array a, const run_bit_array &b) {
+  return a &= b;
+}
+inline run_bit_array operator|(run_bit_array a, const run_bit_array &b) {
+  return a |= b;
+}
+inline run_bit_array operator^(run_bit_array a, const run_bit_array &b) {
+  return a ^= b;
+}
+
+} // namespace bitstring
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef header_bitstring_serialization_hpp
+#define header_bitstring_serialization_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_view.hpp"
+
+namespace bitstring {
+
+// Record format for a single bit sequence:
+//   LEB128 varint bit count, followed by ceil(bits / 8) bytes holding the
+//   bits LSB first (bit i is bit i % 8 of byte i / 8), padding bits are 0
+std::size_t serialized_size(bit_view bits) noexcept;
+std::vector<std::uint8_t> serialize(bit_view bits);
+void serialize(std::ostream &os, bit_view bits);
+// throw decode_error on truncated or malformed input, consumed is set to
+// the number of bytes the record occupied
+bit_array deserialize(const std::uint8_t *data, std::size_t size,
+                      std::size_t *consumed = nullptr);
+bit_array deserialize(std::istream &is);
+
+// Batch format for many bit sequences, all integers little endian:
+//   header  "BSTB", version (1 byte), 3 zero bytes
+//   data    all sequences back to back without padding, as 32 bit words
+//   index   one uint64 per sequence: bit position where it ends in data
+//   footer  uint64 sequence count, uint64 data word count
+// The index is written last, such that batches can be streamed out. Data
+// starts at byte 8, so a 4 byte aligned buffer (e.g. an mmapped file) can
+// be viewed without copying.
+inline constexpr std::uint8_t batch_version = 1;
+
+class batch_writer {
+public:
+  explicit batch_writer(std::ostream &os);
+
+  batch_writer &append(bit_view bits);
+  // write outstanding data, the index and the footer; must be called once
+  // after the last append
+  void finish();
+
+private:
+  void write_word(std::uint32_t word);
+  void flush();
+
+  std::ostream &os_;
+  std::vector<std::uint64_t> ends_;
+  std::uint64_t acc_{0};
+  std::size_t acc_bits_{0};
+  std::uint64_t bitcnt_{0};
+  std::uint64_t words_{0};
+  std::vector<char> buffer_;
+};
+
+// zero-copy view of a serialized batch, the buffer must outlive the view.
+// Throws decode_error on malformed input and std::invalid_argument if the
+// buffer is not aligned to 4 bytes or the host is not little endian.
+class batch_view {
+public:
+  batch_view(const void *data, std::size_t size);
+
+  std::size_t size() const noexcept { return count_; }
+  bool empty() const noexcept { return count_ == 0; }
+  bit_view operator[](std::size_t idx) const noexcept;
+
+private:
+  std::uint64_t end(std::size_t idx) const noexcept;
+
+  const bit_view::storage_type *words_;
+  const std::uint8_t *index_;
+  std::size_t count_;
+};
+
+// portable, copying batch reader
+std::vector<bit_array> read_batch(std::istream &is);
+
+} // namespace bitstring
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef header_bitstring_stats_hpp
+#define header_bitstring_stats_hpp
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace bitstring::stats {
+
+// Opt-in instrumentation of bit_array operations, enabled by building with
+// BITSTRING_STATS defined (cmake option BITSTRING_ENABLE_STATS). Without it
+// the recording macros expand to nothing and snapshots stay zero.
+//
+// Counters are global and updated with relaxed atomics, so they are exact
+// but add contention when many threads work on bit_arrays at once.
+#ifdef BITSTRING_STATS
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+enum class op : std::size_t {
+  parse,         // construction from a string literal
+  compare,       // operator==, slow path: units not aligned
+  append_bit,    // append(bool)
+  append,        // append of a bit_array or view, slow path: self-aliasing
+  prepend,       // prepend
+  reserve,       // reserve
+  reserve_front, // reserve_front, always reallocates
+  rotate,        // rotate_left / rotate_right
+  reverse,       // reverse
+  repeat,        // operator*
+};
+inline constexpr std::size_t op_count = 10;
+
+const char *name(op o) noexcept;
+
+struct counters {
+  std::uint64_t calls{0};
+  // bits the operations worked on
+  std::uint64_t bits{0};
+  // reallocations of the storage and their size in bytes
+  std::uint64_t allocations{0};
+  std::uint64_t allocated_bytes{0};
+  std::uint64_t slow_paths{0};
+};
+
+struct snapshot {
+  std::array<counters, op_count> ops{};
+
+  const counters &operator[](op o) const noexcept {
+    return ops[static_cast<std::size_t>(o)];
+  }
+};
+
+// copy of the current counters, consistent per counter but not across them
+snapshot take_snapshot() noexcept;
+void reset() noexcept;
+
+struct event {
+  op operation;
+  std::uint64_t bits;
+  std::uint64_t allocated_bytes;
+  bool slow_path;
+};
+// called for every recorded operation, from the thread that performed it;
+// nullptr disables tracing
+using trace_hook = void (*)(const event &);
+void set_trace_hook(trace_hook hook) noexcept;
+
+namespace detail {
+void record(op o, std::uint64_t bits, std::uint64_t allocated_bytes,
+            bool slow_path) noexcept;
+
+// records o when leaving the scope, counting a reallocation if the
+// capacity of storage changed
+template <typename Storage> class scope {
+  op op_;
+  const Storage &storage_;
+  std::size_t capacity_;
+  std::uint64_t bits_;
+  bool slow_path_;
+
+public:
+  scope(op o, const Storage &storage, std::uint64_t bits,
+        bool slow_path = false) noexcept
+      : op_(o), storage_(storage), capacity_(storage.capacity()), bits_(bits),
+        slow_path_(slow_path) {}
+  scope(const scope &) = delete;
+  scope &operator=(const scope &) = delete;
+  ~scope() {
+    const auto capacity = storage_.capacity();
+    record(op_, bits_,
+           capacity == capacity_
+               ? 0
+               : capacity * sizeof(typename Storage::value_type),
+           slow_path_);
+  }
+  void slow_path() noexcept { slow_path_ = true; }
+};
+} // namespace detail
+
+} // namespace bitstring::stats
+
+#ifdef BITSTRING_STATS
+// record an operation that allocated the given number of bytes
+#define BITSTRING_STATS_RECORD(o, bits, allocated_bytes, slow_path)           \
+  ::bitstring::stats::detail::record(::bitstring::stats::op::o, bits,        \
+                                     allocated_bytes, slow_path)
+// record an operation on storage when leaving the enclosing scope
+#define BITSTRING_STATS_SCOPE(o, storage, bits)                               \
+  ::bitstring::stats::detail::scope<std::decay_t<decltype(storage)>>         \
+      bitstring_stats_scope(::bitstring::stats::op::o, storage, bits)
+// mark the operation of the enclosing BITSTRING_STATS_SCOPE as slow
+#define BITSTRING_STATS_SLOW_PATH() bitstring_stats_scope.slow_path()
+#else
+#define BITSTRING_STATS_RECORD(o, bits, allocated_bytes, slow_path) ((void)0)
+#define BITSTRING_STATS_SCOPE(o, storage, bits) ((void)0)
+#define BITSTRING_STATS_SLOW_PATH() ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,422 @@
+#include "bitstring/algorithm.hpp"
+#include "bitstring/bit_ops.hpp"
+#include "bitstring/bit_stream.hpp"
+#include "bitstring/endian.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+
+namespace bitstring {
+
+namespace {
+using storage_type = bit_view::storage_type;
+constexpr std::size_t unit_bits = detail::word_bits<storage_type>;
+
+// candidate positions [first, last] are checked, needle must fit at last
+std::size_t find_range(bit_view haystack, bit_view needle, std::size_t first,
+                       std::size_t last) noexcept {
+  const auto head_bits = std::min(needle.size(), unit_bits);
+  const auto head = needle.bits(0, head_bits);
+  const auto head_mask = detail::low_mask<std::uint64_t>(head_bits);
+  const auto tail = needle.subview(head_bits, needle.size() - head_bits);
+
+  // one 64 bit window covers the head at unit_bits consecutive positions
+  for (auto base = first - first % unit_bits; base <= last;
+       base += unit_bits) {
+    const auto window = detail::load_u64(
+        haystack.data(), haystack.offset() + base,
+        std::min<std::size_t>(64, haystack.size() - base));
+    const auto from = std::max(first, base) - base;
+    const auto to = std::min(last - base, unit_bits - 1);
+    for (auto s = from; s <= to; s++) {
+      if (((window >> s) & head_mask) == head &&
+          haystack.subview(base + s + head_bits, tail.size()) == tail) {
+        return base + s;
+      }
+    }
+  }
+  return npos;
+}
+
+std::size_t chunk_size(const execution::parallel_policy &policy) noexcept {
+  return std::max(unit_bits,
+                  policy.chunk_bits - policy.chunk_bits % unit_bits);
+}
+
+std::size_t chunk_count(std::size_t bits, std::size_t chunk) noexcept {
+  return (bits + chunk - 1) / chunk;
+}
+
+constexpr std::size_t digit_bits = 8;
+// digit value (first bit most significant, missing bits 0) times the
+// number of possible digit lengths plus the digit length, such that a
+// shorter digit orders before all its extensions
+constexpr std::size_t digit_lengths = digit_bits + 1;
+constexpr std::size_t digit_keys = (1U << digit_bits) * digit_lengths;
+constexpr std::size_t radix_cutoff = 64;
+
+std::size_t digit_key(const bit_array &a, std::size_t pos) noexcept {
+  const auto len = std::min(digit_bits, a.size() - pos);
+  if (len == 0) {
+    return 0;
+  }
+  const auto v = static_cast<std::uint8_t>(a.view().bits(pos, len));
+  return std::size_t{detail::bitflipped(v)} * digit_lengths + len;
+}
+} // namespace
+
+std::size_t count(bit_view bits) noexcept {
+  std::size_t cnt = 0;
+  for (std::size_t pos = 0; pos < bits.size(); pos += unit_bits) {
+    const auto n = std::min(unit_bits, bits.size() - pos);
+    cnt += detail::popcount(bits.bits(pos, n));
+  }
+  return cnt;
+}
+
+std::size_t count(const execution::parallel_policy &policy, bit_view bits) {
+  if (bits.size() < policy.min_bits) {
+    return count(bits);
+  }
+  const auto chunk = chunk_size(policy);
+  std::atomic<std::size_t> cnt{0};
+  detail::parallel_for(
+      chunk_count(bits.size(), chunk), policy.threads, [&](std::size_t i) {
+        const auto first = i * chunk;
+        const auto n = std::min(chunk, bits.size() - first);
+        cnt += count(bits.subview(first, n));
+      });
+  return cnt;
+}
+
+std::size_t find(bit_view haystack, bit_view needle,
+                 std::size_t start) noexcept {
+  if (needle.size() > haystack.size() ||
+      start > haystack.size() - needle.size()) {
+    return npos;
+  }
+  if (needle.empty()) {
+    return start;
+  }
+  return find_range(haystack, needle, start,
+                    haystack.size() - needle.size());
+}
+
+std::size_t find(const execution::parallel_policy &policy, bit_view haystack,
+                 bit_view needle, std::size_t start) {
+  if (haystack.size() < policy.min_bits || needle.empty() ||
+      needle.size() > haystack.size() ||
+      start > haystack.size() - needle.size()) {
+    return find(haystack, needle, start);
+  }
+  // chunks partition the candidate positions, the needle may extend into
+  // the following chunk so matches straddling a boundary are found as well
+  const auto last = haystack.size() - needle.size();
+  const auto chunk = chunk_size(policy);
+  std::atomic<std::size_t> found{npos};
+  detail::parallel_for(
+      chunk_count(last - start + 1, chunk), policy.threads,
+      [&](std::size_t i) {
+        const auto first = start + i * chunk;
+        if (first > found) {
+          return;
+        }
+        const auto pos = find_range(haystack, needle, first,
+                                    std::min(last, first + chunk - 1));
+        for (auto prev = found.load(); pos < prev;) {
+          if (found.compare_exchange_weak(prev, pos)) {
+            break;
+          }
+        }
+      });
+  return found;
+}
+
+std::size_t hamming_distance(bit_view a, bit_view b) {
+  if (a.size() != b.size()) {
+    throw std::length_error("hamming distance needs equal sizes");
+  }
+  return detail::distance_bits(a.data(), a.offset(), b.data(), b.offset(),
+                               a.size());
+}
+
+// The pattern is pre-shifted to every bit position within a unit, with a
+// mask of the valid bits. An offset then compares whole haystack units
+// against the matching table entry without realigning either side, and
+// stops as soon as max_errors is exceeded.
+std::vector<std::size_t> correlate(bit_view haystack, bit_view pattern,
+                                   std::size_t max_errors) {
+  std::vector<std::size_t> ret;
+  if (pattern.size() > haystack.size()) {
+    return ret;
+  }
+  const auto units = bit_array::storage_units(unit_bits - 1 + pattern.size());
+  std::vector<storage_type> shifted(unit_bits * units);
+  std::vector<storage_type> masks(unit_bits * units);
+  for (std::size_t k = 0; k < unit_bits; k++) {
+    detail::copy_bits(shifted.data() + k * units, k, pattern.data(),
+                      pattern.offset(), pattern.size());
+    detail::fill_bits(masks.data() + k * units, k, true, pattern.size());
+  }
+
+  const auto last = haystack.size() - pattern.size();
+  for (std::size_t s = 0; s <= last; s++) {
+    const auto bit = haystack.offset() + s;
+    const auto k = bit % unit_bits;
+    const auto *hay = haystack.data() + bit / unit_bits;
+    const auto *pat = shifted.data() + k * units;
+    const auto *mask = masks.data() + k * units;
+    const auto cnt = bit_array::storage_units(k + pattern.size());
+    std::size_t errors = 0;
+    for (std::size_t i = 0; i < cnt && errors <= max_errors; i++) {
+      errors += detail::popcount((hay[i] ^ pat[i]) & mask[i]);
+    }
+    if (errors <= max_errors) {
+      ret.push_back(s);
+    }
+  }
+  return ret;
+}
+
+std::size_t first_mismatch(bit_view a, bit_view b) noexcept {
+  const auto common = std::min(a.size(), b.size());
+  const auto pos =
+      detail::mismatch_bits(a.data(), a.offset(), b.data(), b.offset(), common);
+  return pos == common && a.size() == b.size() ? npos : pos;
+}
+
+namespace {
+// calls visit(bit_range) for every maximal range of differing bits until it
+// returns false
+template <typename Visitor>
+void visit_diff(bit_view a, bit_view b, Visitor visit) {
+  const auto common = std::min(a.size(), b.size());
+  auto in = false;
+  std::size_t start = 0;
+  for (auto i = first_mismatch(a, b); i < common; i += 64) {
+    const auto len = std::min<std::size_t>(64, common - i);
+    const auto mask = detail::low_mask<std::uint64_t>(len);
+    const auto x = detail::load_u64(a.data(), a.offset() + i, len) ^
+                   detail::load_u64(b.data(), b.offset() + i, len);
+    // alternately search for the start and the end of a range
+    for (std::size_t from = 0;;) {
+      const auto y =
+          (in ? ~x : x) & mask & ~detail::low_mask<std::uint64_t>(from);
+      if (y == 0) {
+        break;
+      }
+      from = detail::countr_zero(y);
+      if (in && !visit(bit_range{start, i + from - start})) {
+        return;
+      }
+      start = i + from;
+      in = !in;
+    }
+  }
+  if (a.size() != b.size()) {
+    visit(bit_range{in ? start : common, std::max(a.size(), b.size()) -
+                                             (in ? start : common)});
+  } else if (in) {
+    visit(bit_range{start, common - start});
+  }
+}
+
+void append_bits(std::string &out, bit_view bits, bit_range r) {
+  constexpr std::size_t max_bits = 32;
+  const auto end = std::min(r.pos + r.length, bits.size());
+  if (r.pos >= end) {
+    out += "-";
+    return;
+  }
+  out += "0b";
+  out += bits.subview(r.pos, std::min(end - r.pos, max_bits)).bin();
+  if (end - r.pos > max_bits) {
+    out += "...";
+  }
+}
+} // namespace
+
+std::vector<bit_range> diff(bit_view a, bit_view b, std::size_t max_ranges) {
+  std::vector<bit_range> ret;
+  if (max_ranges == 0) {
+    return ret;
+  }
+  visit_diff(a, b, [&](bit_range r) {
+    ret.push_back(r);
+    return ret.size() < max_ranges;
+  });
+  return ret;
+}
+
+std::string diff_summary(bit_view a, bit_view b, std::size_t max_ranges) {
+  std::string ranges;
+  std::size_t range_count = 0;
+  std::size_t bit_count = 0;
+  visit_diff(a, b, [&](bit_range r) {
+    if (range_count < max_ranges) {
+      ranges += "\n  [" + std::to_string(r.pos) + ", " +
+                std::to_string(r.pos + r.length) + "): ";
+      append_bits(ranges, a, r);
+      ranges += " != ";
+      append_bits(ranges, b, r);
+    }
+    range_count++;
+    bit_count += r.length;
+    return true;
+  });
+  if (range_count == 0) {
+    return {};
+  }
+  auto ret = "sizes " + std::to_string(a.size()) + " and " +
+             std::to_string(b.size()) + ", " + std::to_string(bit_count) +
+             " differing bits in " + std::to_string(range_count) + " ranges" +
+             ranges;
+  if (range_count > max_ranges) {
+    ret += "\n  ... " + std::to_string(range_count - max_ranges) +
+           " more ranges";
+  }
+  return ret;
+}
+
+bit_array extract(bit_view bits, bit_view mask) {
+  if (bits.size() != mask.size()) {
+    throw std::length_error("extract needs a mask of the same size");
+  }
+  bit_writer out(count(mask));
+  for (std::size_t pos = 0; pos < bits.size(); pos += 64) {
+    const auto n = std::min<std::size_t>(64, bits.size() - pos);
+    const auto m = detail::load_u64(mask.data(), mask.offset() + pos, n);
+    const auto x = detail::load_u64(bits.data(), bits.offset() + pos, n);
+    out.write(detail::pext(x, m), detail::popcount(m));
+  }
+  return out.finish();
+}
+
+bit_array deposit(bit_view mask, bit_view values) {
+  if (values.size() != count(mask)) {
+    throw std::length_error("deposit needs one value per set mask bit");
+  }
+  bit_writer out(mask.size());
+  std::size_t used = 0;
+  for (std::size_t pos = 0; pos < mask.size(); pos += 64) {
+    const auto n = std::min<std::size_t>(64, mask.size() - pos);
+    const auto m = detail::load_u64(mask.data(), mask.offset() + pos, n);
+    const auto k = detail::popcount(m);
+    const auto v = detail::load_u64(values.data(), values.offset() + used, k);
+    out.write(detail::pdep(v, m), n);
+    used += k;
+  }
+  return out.finish();
+}
+
+bool equal(const execution::parallel_policy &policy, bit_view a, bit_view b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  if (a.size() < policy.min_bits) {
+    return a == b;
+  }
+  const auto chunk = chunk_size(policy);
+  std::atomic<bool> differs{false};
+  detail::parallel_for(
+      chunk_count(a.size(), chunk), policy.threads, [&](std::size_t i) {
+        if (differs) {
+          return;
+        }
+        const auto first = i * chunk;
+        const auto n = std::min(chunk, a.size() - first);
+        if (a.subview(first, n) != b.subview(first, n)) {
+          differs = true;
+        }
+      });
+  return !differs;
+}
+
+bool starts_with(const execution::parallel_policy &policy, bit_view bits,
+                 bit_view prefix) {
+  return prefix.size() <= bits.size() &&
+         equal(policy, bits.subview(0, prefix.size()), prefix);
+}
+
+void radix_sort(std::vector<bit_array> &arrays) {
+  struct bucket {
+    std::size_t first;
+    std::size_t last;
+    std::size_t pos;
+  };
+  std::vector<bucket> todo{{0, arrays.size(), 0}};
+  std::vector<bit_array> tmp(arrays.size());
+  std::vector<std::uint16_t> keys;
+  std::array<std::size_t, digit_keys + 1> starts{};
+  const auto at = [](std::vector<bit_array> &v, std::size_t i) {
+    return std::next(v.begin(), static_cast<std::ptrdiff_t>(i));
+  };
+
+  while (!todo.empty()) {
+    const auto b = todo.back();
+    todo.pop_back();
+    if (b.last - b.first <= radix_cutoff) {
+      // all elements share the first pos bits
+      const auto pos = b.pos;
+      std::sort(at(arrays, b.first), at(arrays, b.last),
+                [pos](const bit_array &x, const bit_array &y) {
+                  return compare(x.view().subview(pos, x.size() - pos),
+                                 y.view().subview(pos, y.size() - pos)) < 0;
+                });
+      continue;
+    }
+
+    // elements that end at pos have a unique key and order first
+    keys.clear();
+    starts.fill(0);
+    for (auto i = b.first; i < b.last; i++) {
+      const auto key = digit_key(arrays[i], b.pos);
+      keys.push_back(static_cast<std::uint16_t>(key));
+      starts[key + 1]++;
+    }
+    for (std::size_t k = 1; k < starts.size(); k++) {
+      starts[k] += starts[k - 1];
+    }
+    auto next = starts;
+    for (auto i = b.first; i < b.last; i++) {
+      tmp[b.first + next[keys[i - b.first]]++] = std::move(arrays[i]);
+    }
+    std::move(at(tmp, b.first), at(tmp, b.last), at(arrays, b.first));
+
+    // only full digits can continue, shorter ones are fully ordered
+    for (std::size_t k = digit_bits; k < digit_keys; k += digit_lengths) {
+      if (starts[k + 1] - starts[k] > 1) {
+        todo.push_back({b.first + starts[k], b.first + starts[k + 1],
+                        b.pos + digit_bits});
+      }
+    }
+  }
+}
+
+std::string bin(const execution::parallel_policy &policy, bit_view bits) {
+  if (bits.size() < policy.min_bits) {
+    return bits.bin();
+  }
+  auto ret = std::string(bits.size(), '0');
+  const auto chunk = chunk_size(policy);
+  detail::parallel_for(
+      chunk_count(bits.size(), chunk), policy.threads, [&](std::size_t i) {
+        const auto first = i * chunk;
+        const auto last = std::min(first + chunk, bits.size());
+        for (auto pos = first; pos < last; pos += unit_bits) {
+          const auto n = std::min(unit_bits, last - pos);
+          const auto unit = bits.bits(pos, n);
+          for (std::size_t b = 0; b < n; b++) {
+            ret[pos + b] = static_cast<char>('0' + ((unit >> b) & 1U));
+          }
+        }
+      });
+  return ret;
+}
+
+} // namespace bitstring
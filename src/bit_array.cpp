@@ -1,8 +1,12 @@
 #include "bitstring/bit_array.hpp"
+#include "bitstring/bit_stream.hpp"
 #include "bitstring/exceptions.hpp"
+#include "bitstring/stats.hpp"
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
+#include <utility>
 
 namespace bitstring {
 
@@ -11,35 +15,186 @@ constexpr int bits_per_byte = 8;
 bit_array::bit_array() : bitcnt_(0), offset_(0) {}
 
 #ifdef __cpp_lib_string_view
-bit_array::bit_array(std::string_view s) : bitcnt_(0), offset_(0) {
-  if (s.substr(0, 2) == "0b") {
-    bits_.reserve(storage_units(s.size() - 2));
-    storage_type e = 0;
-    unsigned int bits = 0;
-    for (auto c : s.substr(2)) {
-      if (c == '\'' || c == '_') {
+namespace {
+constexpr std::uint64_t byte_ones = 0x0101010101010101ULL;
+constexpr std::uint64_t byte_highs = 0x8080808080808080ULL;
+constexpr std::size_t swar_chars = 8;
+
+constexpr bool is_separator(char c) noexcept { return c == '\'' || c == '_'; }
+
+// value of a digit in the given base, -1 if it is none
+constexpr int digit_value(char c, unsigned int base) noexcept {
+  int v = -1;
+  if (c >= '0' && c <= '9') {
+    v = c - '0';
+  } else if (c >= 'a' && c <= 'f') {
+    v = c - 'a' + 10;
+  } else if (c >= 'A' && c <= 'F') {
+    v = c - 'A' + 10;
+  }
+  return v >= 0 && static_cast<unsigned int>(v) < base ? v : -1;
+}
+
+std::uint64_t load_chars(const char *p) noexcept {
+  std::uint64_t v = 0;
+  for (std::size_t i = 0; i < swar_chars; i++) {
+    v |= static_cast<std::uint64_t>(static_cast<unsigned char>(p[i]))
+         << (bits_per_byte * i);
+  }
+  return v;
+}
+
+// high bit of each byte set if lo <= byte <= hi, bytes must be < 0x80
+constexpr std::uint64_t bytes_in_range(std::uint64_t v, std::uint8_t lo,
+                                       std::uint8_t hi) noexcept {
+  const auto ge_lo = v + byte_ones * (0x80U - lo);
+  const auto gt_hi = v + byte_ones * (0x7fU - hi);
+  return ge_lo & ~gt_hi & byte_highs;
+}
+
+// 8 binary digits to 8 bits, character i at bit i; false if any character
+// is not a binary digit
+bool decode_bin8(const char *p, std::uint32_t &out) noexcept {
+  auto v = load_chars(p) ^ (byte_ones * '0');
+  if ((v & ~byte_ones) != 0) {
+    return false;
+  }
+  v = (v | (v >> 7U)) & 0x0003000300030003ULL;
+  v = (v | (v >> 14U)) & 0x0000000f0000000fULL;
+  out = static_cast<std::uint32_t>((v | (v >> 28U)) & 0xffU);
+  return true;
+}
+
+// 8 hex digits to 32 bits, the digits in order and each digit MSB first
+bool decode_hex8(const char *p, std::uint32_t &out) noexcept {
+  const auto v = load_chars(p);
+  if ((v & byte_highs) != 0) {
+    return false;
+  }
+  const auto letters =
+      bytes_in_range(v, 'a', 'f') | bytes_in_range(v, 'A', 'F');
+  if ((bytes_in_range(v, '0', '9') | letters) != byte_highs) {
+    return false;
+  }
+  // '0'..'9' have low nibbles 0..9, letters 1..6
+  auto n = (v & 0x0f0f0f0f0f0f0f0fULL) + (letters >> 7U) * 9;
+  // reverse the nibbles, then pack them
+  n = ((n & 0x0505050505050505ULL) << 1U) | ((n >> 1U) & 0x0505050505050505ULL);
+  n = ((n & 0x0303030303030303ULL) << 2U) | ((n >> 2U) & 0x0303030303030303ULL);
+  n = (n | (n >> 4U)) & 0x00ff00ff00ff00ffULL;
+  n = (n | (n >> 8U)) & 0x0000ffff0000ffffULL;
+  out = static_cast<std::uint32_t>(n | (n >> 16U));
+  return true;
+}
+
+// digits of a literal body, MSB first per digit, appended to out
+void decode_digits(std::string_view s, unsigned int bits_per_digit,
+                   bit_writer &out) {
+  const auto base = 1U << bits_per_digit;
+  std::size_t i = 0;
+  while (i < s.size()) {
+    std::uint32_t word = 0;
+    if (s.size() - i >= swar_chars) {
+      if (bits_per_digit == 4 && decode_hex8(s.data() + i, word)) {
+        out.write(word, 4 * swar_chars);
+        i += swar_chars;
         continue;
       }
-
-      if (c != '0' && c != '1') {
-        throw parse_error("invalid character in bitstring");
+      if (bits_per_digit == 1 && decode_bin8(s.data() + i, word)) {
+        out.write(word, swar_chars);
+        i += swar_chars;
+        continue;
       }
+    }
+    // separators, invalid characters and the tail
+    const auto c = s[i++];
+    if (is_separator(c)) {
+      continue;
+    }
+    const auto v = digit_value(c, base);
+    if (v < 0) {
+      throw parse_error("invalid character in bitstring");
+    }
+    std::uint32_t flipped = 0;
+    for (unsigned int b = 0; b < bits_per_digit; b++) {
+      flipped |= ((static_cast<std::uint32_t>(v) >> b) & 1U)
+                 << (bits_per_digit - 1 - b);
+    }
+    out.write(flipped, bits_per_digit);
+  }
+}
+} // namespace
 
-      e |= static_cast<storage_type>(c - '0') << bits++;
-      if (bits == sizeof(storage_type) * bits_per_byte) {
-        bitcnt_ += bits;
-        bits_.push_back(e);
-        bits = 0;
-        e = 0;
-      }
+bit_array::bit_array(std::string_view s) : bitcnt_(0), offset_(0) {
+  const auto prefix = s.substr(0, 2);
+  const auto has_prefix = prefix == "0b" || prefix == "0o" || prefix == "0x";
+
+  // optional explicit length: decimal digits followed by ' before the prefix
+  bool has_length = false;
+  std::size_t length = 0;
+  if (!has_prefix && !s.empty() && s[0] >= '0' && s[0] <= '9') {
+    const auto sep = s.find('\'');
+    if (sep == std::string_view::npos) {
+      throw parse_error("invalid literal prefix");
     }
-    if (bits != 0) {
-      bits_.push_back(e);
-      bitcnt_ += bits;
+    for (auto c : s.substr(0, sep)) {
+      if (c < '0' || c > '9') {
+        throw parse_error("invalid literal length");
+      }
+      length = length * 10 + static_cast<std::size_t>(c - '0');
     }
+    has_length = true;
+    s.remove_prefix(sep + 1);
+  }
+
+  unsigned int bits_per_digit = 0;
+  if (s.substr(0, 2) == "0b") {
+    bits_per_digit = 1;
+  } else if (s.substr(0, 2) == "0o") {
+    bits_per_digit = 3;
+  } else if (s.substr(0, 2) == "0x") {
+    bits_per_digit = 4;
   } else {
     throw parse_error("invalid literal prefix");
   }
+  s.remove_prefix(2);
+
+  if (!has_length) {
+    bit_writer out(s.size() * bits_per_digit);
+    decode_digits(s, bits_per_digit, out);
+    *this = out.finish();
+    BITSTRING_STATS_RECORD(parse, bitcnt_,
+                           bits_.capacity() * sizeof(storage_type), false);
+    return;
+  }
+
+  // like Verilog sized literals the value is right aligned: shorter values
+  // are zero extended in front, longer ones may only have leading zeros
+  const auto digits =
+      s.size() - static_cast<std::size_t>(
+                     std::count_if(s.begin(), s.end(), is_separator));
+  const auto bits = digits * bits_per_digit;
+  bit_writer out(std::max(length, bits));
+  for (auto pad = length > bits ? length - bits : 0; pad != 0;) {
+    const auto n = std::min<std::size_t>(pad, 64);
+    out.write(0, n);
+    pad -= n;
+  }
+  decode_digits(s, bits_per_digit, out);
+  auto parsed = out.finish();
+  if (length < bits) {
+    constexpr auto unit_bits = detail::word_bits<storage_type>;
+    const auto excess = bits - length;
+    for (std::size_t pos = 0; pos < excess; pos += unit_bits) {
+      if (parsed.view().bits(pos, std::min(unit_bits, excess - pos)) != 0) {
+        throw parse_error("literal exceeds explicit length");
+      }
+    }
+    parsed = bit_array(parsed.view().subview(excess, length));
+  }
+  *this = std::move(parsed);
+  BITSTRING_STATS_RECORD(parse, bitcnt_,
+                         bits_.capacity() * sizeof(storage_type), false);
 }
 #endif // __cpp_lib_string_view
 
@@ -55,7 +210,7 @@ bit_array::bit_array(std::vector<uint8_t> vec)
     }
     bits_[bits_idx] = e;
   }
-  {
+  if (vec_idx < vec.size()) {
     storage_type e = 0;
     for (size_t j = 0; vec_idx < vec.size(); j++, vec_idx++) {
       e |= static_cast<storage_type>(vec[vec_idx]) << (j * bits_per_byte);
@@ -64,14 +219,33 @@ bit_array::bit_array(std::vector<uint8_t> vec)
   }
 }
 
+bit_array::bit_array(bit_view v)
+    : bits_(storage_units(v.size())), bitcnt_(v.size()), offset_(0) {
+  detail::copy_bits(bits_.data(), 0, v.data(), v.offset(), v.size());
+}
+
+bit_array::bit_array(std::vector<storage_type> units, bitcnt_t bitcnt)
+    : bits_(std::move(units)), bitcnt_(bitcnt), offset_(0) {
+  bits_.resize(storage_units(bitcnt));
+  constexpr auto unit_bits = detail::word_bits<storage_type>;
+  if (bitcnt % unit_bits != 0) {
+    bits_.back() &= detail::low_mask<storage_type>(bitcnt % unit_bits);
+  }
+}
+
 bool bit_array::operator==(const bit_array &other) const noexcept {
   if (this->size() != other.size()) {
     return false;
   }
+  if (this->empty()) {
+    return true;
+  }
 
   if (this->offset_ == 0 && other.offset_ == 0) {
+    BITSTRING_STATS_RECORD(compare, bitcnt_, 0, false);
     return compare_fast(other);
   }
+  BITSTRING_STATS_RECORD(compare, bitcnt_, 0, true);
   return compare_slow(other);
 }
 
@@ -89,12 +263,8 @@ bool bit_array::compare_fast(const bit_array &other) const noexcept {
 }
 
 bool bit_array::compare_slow(const bit_array &other) const noexcept {
-  for (bitcnt_t i = 0; i < size(); i++) {
-    if ((*this)[i] != other[i]) {
-      return false;
-    }
-  }
-  return true;
+  return detail::equal_bits(bits_.data(), offset_, other.bits_.data(),
+                            other.offset_, bitcnt_);
 }
 
 bool bit_array::operator!=(const bit_array &other) const noexcept {
@@ -112,6 +282,7 @@ std::size_t bit_array::size() const { return bitcnt_; }
 bool bit_array::empty() const { return bitcnt_ == 0; }
 
 bit_array &bit_array::reserve(bitcnt_t cnt) {
+  BITSTRING_STATS_SCOPE(reserve, bits_, cnt);
   bits_.reserve(storage_units(cnt));
   return *this;
 }
@@ -121,6 +292,7 @@ bit_array &bit_array::reserve_front(bitcnt_t cnt) {
   if (cnt < offset_) {
     return *this;
   }
+  BITSTRING_STATS_SCOPE(reserve_front, bits_, cnt);
   auto units_needed = storage_units(cnt);
   std::vector<storage_type> extended(units_needed + bits_.capacity(), 0);
   std::copy(begin(bits_), end(bits_),
@@ -145,30 +317,48 @@ std::string bit_array::bin() const {
 }
 
 bit_array &bit_array::append(bool bit) {
-  const auto needed_size = storage_units(bitcnt_ + 1);
+  BITSTRING_STATS_SCOPE(append_bit, bits_, 1);
+  const auto needed_size = storage_units(offset_ + bitcnt_ + 1);
   bits_.resize(needed_size);
 
   auto idx = shifted_idx(bitcnt_);
+  bits_[idx.unit()] &= ~idx.bit_mask();
   bits_[idx.unit()] |= static_cast<storage_type>(bit) << idx.bit_offset();
   bitcnt_++;
   return *this;
 }
 
 bit_array &bit_array::append(const bit_array &b) {
-  const auto needed_size = storage_units(bitcnt_ + b.bitcnt_);
+  BITSTRING_STATS_SCOPE(append, bits_, b.bitcnt_);
+  const auto needed_size = storage_units(offset_ + bitcnt_ + b.bitcnt_);
   bits_.resize(needed_size);
 
-  for (size_t ib = 0; ib < b.bitcnt_; ib++) {
-    auto this_idx = shifted_idx(bitcnt_ + ib);
-    bits_[this_idx.unit()] |= static_cast<storage_type>(b[ib])
-                              << this_idx.bit_offset();
-  }
+  // b.bits_ is only read after the resize such that self appending works
+  detail::copy_bits(bits_.data(), offset_ + bitcnt_, b.bits_.data(),
+                    b.offset_, b.bitcnt_);
 
-  // modify bitcnt_ only now such that self appending works
   bitcnt_ += b.bitcnt_;
   return *this;
 }
 
+bit_array &bit_array::append(bit_view b) {
+  BITSTRING_STATS_SCOPE(append, bits_, b.size());
+  const auto *const first = bits_.data();
+  bit_array copy;
+  if (std::less_equal<>()(first, b.data()) &&
+      std::less<>()(b.data(), first + bits_.size())) {
+    // view into this array, resizing could invalidate it
+    BITSTRING_STATS_SLOW_PATH();
+    copy = bit_array(b);
+    b = copy.view();
+  }
+  bits_.resize(storage_units(offset_ + bitcnt_ + b.size()));
+  detail::copy_bits(bits_.data(), offset_ + bitcnt_, b.data(), b.offset(),
+                    b.size());
+  bitcnt_ += b.size();
+  return *this;
+}
+
 #if __cpp_lib_string_view
 bit_array &bit_array::append(std::string_view s) {
   return this->append(bit_array(s)); // do the trivial route for now
@@ -179,15 +369,12 @@ bool bit_array::starts_with(const bit_array &other) const noexcept {
   if (other.size() > size()) {
     return false;
   }
-  for (bitcnt_t b = 0; b < other.size(); b++) {
-    if ((*this)[b] != other[b]) {
-      return false;
-    }
-  }
-  return true;
+  return detail::equal_bits(bits_.data(), offset_, other.bits_.data(),
+                            other.offset_, other.size());
 }
 
 bit_array &bit_array::prepend(const bit_array &b) {
+  BITSTRING_STATS_SCOPE(prepend, bits_, b.bitcnt_);
   const auto needed_units = storage_units(b.bitcnt_);
   bits_.insert(cbegin(bits_), needed_units, storage_type{0});
   offset_ += needed_units * sizeof(storage_type) * bits_per_byte - b.bitcnt_;
@@ -207,6 +394,93 @@ bit_array &bit_array::prepend(std::string_view s) {
 }
 #endif
 
+// Rotations copy the smaller part to the other end of the data and move
+// offset_, so the bulk of the bits stays in place. Unused units in front
+// are only dropped once they outnumber the used ones.
+bit_array &bit_array::rotate_left(bitcnt_t n) {
+  if (bitcnt_ == 0) {
+    return *this;
+  }
+  n %= bitcnt_;
+  if (n > bitcnt_ / 2) {
+    return rotate_right(bitcnt_ - n);
+  }
+  if (n == 0) {
+    return *this;
+  }
+  BITSTRING_STATS_SCOPE(rotate, bits_, bitcnt_);
+  const auto end = offset_ + bitcnt_;
+  bits_.resize(storage_units(end + n), 0);
+  detail::copy_bits(bits_.data(), end, bits_.data(), offset_, n);
+  detail::fill_bits(bits_.data(), offset_, false, n);
+  offset_ += n;
+  compact_front();
+  return *this;
+}
+
+bit_array &bit_array::rotate_right(bitcnt_t n) {
+  if (bitcnt_ == 0) {
+    return *this;
+  }
+  n %= bitcnt_;
+  if (n > bitcnt_ / 2) {
+    return rotate_left(bitcnt_ - n);
+  }
+  if (n == 0) {
+    return *this;
+  }
+  BITSTRING_STATS_SCOPE(rotate, bits_, bitcnt_);
+  if (offset_ < n) {
+    const auto units = storage_units(n - offset_);
+    bits_.insert(begin(bits_), units, storage_type{0});
+    offset_ += units * sizeof(storage_type) * bits_per_byte;
+  }
+  const auto end = offset_ + bitcnt_;
+  detail::copy_bits(bits_.data(), offset_ - n, bits_.data(), end - n, n);
+  detail::fill_bits(bits_.data(), end - n, false, n);
+  offset_ -= n;
+  bits_.resize(storage_units(offset_ + bitcnt_));
+  return *this;
+}
+
+void bit_array::compact_front() {
+  constexpr auto unit_bits = detail::word_bits<storage_type>;
+  const auto unused = offset_ / unit_bits;
+  if (unused != 0 && unused >= bits_.size() - unused) {
+    using diff_t = decltype(bits_)::difference_type;
+    bits_.erase(begin(bits_), begin(bits_) + static_cast<diff_t>(unused));
+    offset_ -= unused * unit_bits;
+  }
+}
+
+// reversing the order of the units and the bits within each unit reverses
+// the whole span, which only leaves the offset to be adjusted
+bit_array &bit_array::reverse() {
+  if (bitcnt_ == 0) {
+    return *this;
+  }
+  BITSTRING_STATS_RECORD(reverse, bitcnt_, 0, false);
+  using diff_t = decltype(bits_)::difference_type;
+  constexpr auto unit_bits = detail::word_bits<storage_type>;
+  const auto first = offset_ / unit_bits;
+  const auto last = (offset_ + bitcnt_ - 1) / unit_bits + 1;
+  const auto span_first = begin(bits_) + static_cast<diff_t>(first);
+  const auto span_last = begin(bits_) + static_cast<diff_t>(last);
+  std::reverse(span_first, span_last);
+  std::transform(span_first, span_last, span_first,
+                 detail::bitflipped<storage_type>);
+
+  const auto span_end = last * unit_bits;
+  const auto new_offset = first * unit_bits + span_end - offset_ - bitcnt_;
+  // bits around the data were swapped as well, keep them cleared
+  detail::fill_bits(bits_.data(), first * unit_bits, false,
+                    new_offset - first * unit_bits);
+  detail::fill_bits(bits_.data(), new_offset + bitcnt_, false,
+                    span_end - new_offset - bitcnt_);
+  offset_ = new_offset;
+  return *this;
+}
+
 bit_array bit_array::front(bitcnt_t bits) {
   bit_array other;
 
@@ -230,10 +504,37 @@ const std::vector<bit_array::storage_type> &bit_array::data() const {
 }
 
 bit_array operator*(size_t cnt, const bit_array &ba) {
+  using storage_type = bit_array::storage_type;
+  constexpr auto unit_bits = detail::word_bits<storage_type>;
+
+  const auto period = ba.size();
+  const auto total = cnt * period;
   bit_array result;
-  result.reserve(cnt * ba.size());
-  while (cnt-- > 0) {
-    result.append(ba);
+  if (total == 0) {
+    return result;
+  }
+  BITSTRING_STATS_SCOPE(repeat, result.bits_, total);
+  result.bits_.resize(bit_array::storage_units(total));
+  result.bitcnt_ = total;
+  auto *const dst = result.bits_.data();
+
+  if (unit_bits % period == 0) {
+    // period fits a unit evenly, so every unit is the same pattern
+    const auto pattern = detail::replicate(
+        detail::load_bits(ba.bits_.data(), ba.offset_, period), period);
+    std::fill(begin(result.bits_), end(result.bits_), pattern);
+    if (total % unit_bits != 0) {
+      result.bits_.back() &= detail::low_mask<storage_type>(total % unit_bits);
+    }
+    return result;
+  }
+
+  // copy the pattern once, then keep doubling what has been built so far
+  detail::copy_bits(dst, 0, ba.bits_.data(), ba.offset_, period);
+  for (auto built = period; built < total;) {
+    const auto n = std::min(built, total - built);
+    detail::copy_bits(dst, built, dst, 0, n);
+    built += n;
   }
   return result;
 }
@@ -0,0 +1,57 @@
+#include "bitstring/bit_array_pool.hpp"
+#include "bitstring/bit_ops.hpp"
+
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace bitstring {
+
+bit_array_pool &bit_array_pool::reserve(std::size_t sequences, bitcnt_t bits) {
+  units_.reserve(bit_array::storage_units(bits));
+  block_starts_.reserve((sequences + block_size - 1) / block_size);
+  ends_.reserve(sequences);
+  return *this;
+}
+
+std::size_t bit_array_pool::push_back(bit_view bits) {
+  const auto *const first = units_.data();
+  if (std::less_equal<>()(first, bits.data()) &&
+      std::less<>()(bits.data(), first + units_.size())) {
+    // view into this pool, resizing could invalidate it
+    return push_back(bit_array(bits));
+  }
+
+  const auto start = bit_count();
+  const auto idx = ends_.size();
+  if (idx % block_size == 0) {
+    block_starts_.push_back(start);
+  }
+  const auto relative = start + bits.size() - block_starts_.back();
+  if (relative > std::numeric_limits<std::uint32_t>::max()) {
+    if (idx % block_size == 0) {
+      block_starts_.pop_back();
+    }
+    throw std::length_error("bit_array_pool block exceeds 2^32 bits");
+  }
+
+  units_.resize(bit_array::storage_units(start + bits.size()));
+  detail::copy_bits(units_.data(), start, bits.data(), bits.offset(),
+                    bits.size());
+  ends_.push_back(static_cast<std::uint32_t>(relative));
+  return idx;
+}
+
+void bit_array_pool::clear() noexcept {
+  units_.clear();
+  block_starts_.clear();
+  ends_.clear();
+}
+
+bool bit_array_pool::operator==(const bit_array_pool &o) const noexcept {
+  return ends_ == o.ends_ && block_starts_ == o.block_starts_ &&
+         detail::equal_bits(units_.data(), 0, o.units_.data(), 0,
+                            bit_count());
+}
+
+} // namespace bitstring
@@ -0,0 +1,112 @@
+#include "bitstring/bit_fifo.hpp"
+#include "bitstring/bit_ops.hpp"
+#include "bitstring/bit_stream.hpp"
+
+#include <algorithm>
+
+namespace bitstring {
+
+namespace {
+std::size_t round_up_pow2(std::size_t n) noexcept {
+  std::size_t ret = 1;
+  while (ret < n) {
+    ret <<= 1U;
+  }
+  return ret;
+}
+} // namespace
+
+bit_fifo::bit_fifo(std::size_t capacity_bits)
+    : mask_(round_up_pow2(bit_array::storage_units(capacity_bits)) - 1) {
+  units_ = std::make_unique<std::atomic<storage_type>[]>(mask_ + 1);
+}
+
+// stores overwrite whole units, so the unit holding the read position must
+// not be reached again before it was consumed completely
+bool bit_fifo::reserve(std::size_t n) noexcept {
+  const auto pos = write_pos_.load(std::memory_order_relaxed);
+  if (pos + n - read_limit_ <= capacity()) {
+    return true;
+  }
+  const auto read_pos = read_pos_.load(std::memory_order_acquire);
+  read_limit_ = read_pos - read_pos % unit_bits;
+  return pos + n - read_limit_ <= capacity();
+}
+
+// n <= unit_bits bits at pos, keeping the bits before pos in the unit
+void bit_fifo::store(std::uint64_t pos, storage_type value,
+                     std::size_t n) noexcept {
+  const auto shift = pos % unit_bits;
+  value &= detail::low_mask<storage_type>(n);
+  auto &first = unit(pos);
+  const auto kept = shift == 0 ? storage_type{0}
+                               : first.load(std::memory_order_relaxed) &
+                                     detail::low_mask<storage_type>(shift);
+  first.store(kept | (value << shift), std::memory_order_relaxed);
+  if (shift + n > unit_bits) {
+    unit(pos + n).store(value >> (unit_bits - shift),
+                        std::memory_order_relaxed);
+  }
+}
+
+bit_fifo::storage_type bit_fifo::load(std::uint64_t pos,
+                                      std::size_t n) const noexcept {
+  const auto shift = pos % unit_bits;
+  auto value = unit(pos).load(std::memory_order_relaxed) >> shift;
+  if (shift + n > unit_bits) {
+    value |= unit(pos + n).load(std::memory_order_relaxed)
+             << (unit_bits - shift);
+  }
+  return value & detail::low_mask<storage_type>(n);
+}
+
+bool bit_fifo::write(bit_view bits) {
+  if (!reserve(bits.size())) {
+    return false;
+  }
+  const auto pos = write_pos_.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < bits.size(); i += unit_bits) {
+    const auto n = std::min(unit_bits, bits.size() - i);
+    store(pos + i, bits.bits(i, n), n);
+  }
+  write_pos_.store(pos + bits.size(), std::memory_order_release);
+  return true;
+}
+
+bool bit_fifo::write_bits(std::uint64_t value, std::size_t n) {
+  if (!reserve(n)) {
+    return false;
+  }
+  const auto pos = write_pos_.load(std::memory_order_relaxed);
+  if (n > unit_bits) {
+    store(pos, static_cast<storage_type>(value), unit_bits);
+    store(pos + unit_bits, static_cast<storage_type>(value >> unit_bits),
+          n - unit_bits);
+  } else {
+    store(pos, static_cast<storage_type>(value), n);
+  }
+  write_pos_.store(pos + n, std::memory_order_release);
+  return true;
+}
+
+std::size_t bit_fifo::size() const noexcept {
+  return write_pos_.load(std::memory_order_acquire) -
+         read_pos_.load(std::memory_order_relaxed);
+}
+
+bit_array bit_fifo::read(std::size_t n) {
+  const auto pos = read_pos_.load(std::memory_order_relaxed);
+  if (write_limit_ - pos < n) {
+    write_limit_ = write_pos_.load(std::memory_order_acquire);
+  }
+  n = std::min<std::uint64_t>(n, write_limit_ - pos);
+  bit_writer out(n);
+  for (std::size_t i = 0; i < n; i += unit_bits) {
+    const auto k = std::min(unit_bits, n - i);
+    out.write(load(pos + i, k), k);
+  }
+  read_pos_.store(pos + n, std::memory_order_release);
+  return out.finish();
+}
+
+} // namespace bitstring
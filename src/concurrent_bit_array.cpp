@@ -0,0 +1,83 @@
+#include "bitstring/concurrent_bit_array.hpp"
+#include "bitstring/bit_ops.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace bitstring {
+
+concurrent_bit_array::concurrent_bit_array(bitcnt_t size)
+    : bitcnt_(size), lines_(std::make_unique<line[]>(
+                         (bit_array::storage_units(size) + line_units - 1) /
+                         line_units)) {}
+
+void concurrent_bit_array::fetch_or(bitcnt_t pos, bit_view bits) {
+  if (pos > bitcnt_ || bits.size() > bitcnt_ - pos) {
+    throw std::out_of_range("fetch_or exceeds concurrent_bit_array");
+  }
+  for (std::size_t i = 0; i < bits.size();) {
+    const auto dst = pos + i;
+    const auto shift = dst % unit_bits;
+    const auto n = std::min(unit_bits - shift, bits.size() - i);
+    const auto value = bits.bits(i, n) << shift;
+    if (value != 0) {
+      unit(dst / unit_bits).fetch_or(value, std::memory_order_acq_rel);
+    }
+    i += n;
+  }
+}
+
+concurrent_bit_array::bitcnt_t concurrent_bit_array::count() const noexcept {
+  bitcnt_t cnt = 0;
+  for (std::size_t i = 0; i < unit_count(); i++) {
+    cnt += detail::popcount(unit(i).load(std::memory_order_relaxed));
+  }
+  return cnt;
+}
+
+concurrent_bit_array::bitcnt_t
+concurrent_bit_array::claim(bitcnt_t hint) noexcept {
+  const auto units = unit_count();
+  if (units == 0) {
+    return npos;
+  }
+  const auto last_mask =
+      detail::low_mask<storage_type>(bitcnt_ - (units - 1) * unit_bits);
+  const auto first = (hint / unit_bits) % units;
+  for (std::size_t k = 0; k < units; k++) {
+    const auto i = (first + k) % units;
+    auto &u = unit(i);
+    const storage_type valid = i == units - 1 ? last_mask : ~storage_type{0};
+    auto v = u.load(std::memory_order_relaxed);
+    while ((~v & valid) != 0) {
+      const auto b = storage_type{1} << detail::countr_zero(~v & valid);
+      v = u.fetch_or(b, std::memory_order_acq_rel);
+      if ((v & b) == 0) {
+        return i * unit_bits + detail::countr_zero(b);
+      }
+    }
+  }
+  return npos;
+}
+
+concurrent_bit_array::bitcnt_t
+concurrent_bit_array::spread_hint(std::size_t slot,
+                                  std::size_t slots) const noexcept {
+  if (slots == 0) {
+    return 0;
+  }
+  constexpr auto line_bits = line_units * unit_bits;
+  const auto lines = (bitcnt_ + line_bits - 1) / line_bits;
+  return (lines * (slot % slots) / slots) * line_bits;
+}
+
+bit_array concurrent_bit_array::snapshot() const {
+  std::vector<storage_type> units(unit_count());
+  for (std::size_t i = 0; i < units.size(); i++) {
+    units[i] = unit(i).load(std::memory_order_relaxed);
+  }
+  return bit_array(std::move(units), bitcnt_);
+}
+
+} // namespace bitstring
@@ -0,0 +1,71 @@
+#include "bitstring/crc.hpp"
+#include "bitstring/bit_ops.hpp"
+#include "bitstring/endian.hpp"
+
+namespace bitstring {
+
+namespace {
+std::uint64_t reflected(std::uint64_t v, unsigned int width) noexcept {
+  return detail::bitflipped(v) >> (64 - width);
+}
+} // namespace
+
+crc_engine::crc_engine(const crc_params &params)
+    : params_(params), rpoly_(reflected(params.poly, params.width)), reg_(0),
+      table_() {
+  constexpr int bits_per_byte = 8;
+  for (std::uint64_t i = 0; i < 256; i++) {
+    auto c = i;
+    for (int b = 0; b < bits_per_byte; b++) {
+      c = (c & 1U) != 0 ? (c >> 1U) ^ rpoly_ : c >> 1U;
+    }
+    table_[0][i] = c;
+  }
+  for (std::size_t k = 1; k < table_.size(); k++) {
+    for (std::size_t i = 0; i < 256; i++) {
+      const auto prev = table_[k - 1][i];
+      table_[k][i] = (prev >> 8U) ^ table_[0][prev & 0xffU];
+    }
+  }
+  reset();
+}
+
+crc_engine &crc_engine::reset() noexcept {
+  reg_ = reflected(params_.init, params_.width);
+  return *this;
+}
+
+crc_engine &crc_engine::update(bit_view bits) noexcept {
+  using storage_type = bit_view::storage_type;
+  constexpr auto unit_bits = detail::word_bits<storage_type>;
+  static_assert(unit_bits == 32, "slice-by-4 expects 32 bit units");
+
+  auto reg = reg_;
+  std::size_t pos = 0;
+  for (; bits.size() - pos >= unit_bits; pos += unit_bits) {
+    reg ^= bits.bits(pos);
+    reg = (reg >> 32U) ^ table_[3][reg & 0xffU] ^
+          table_[2][(reg >> 8U) & 0xffU] ^ table_[1][(reg >> 16U) & 0xffU] ^
+          table_[0][(reg >> 24U) & 0xffU];
+  }
+  for (; bits.size() - pos >= 8; pos += 8) {
+    reg = (reg >> 8U) ^ table_[0][(reg ^ bits.bits(pos, 8)) & 0xffU];
+  }
+  for (; pos < bits.size(); pos++) {
+    reg = ((reg ^ bits[pos]) & 1U) != 0 ? (reg >> 1U) ^ rpoly_ : reg >> 1U;
+  }
+  reg_ = reg;
+  return *this;
+}
+
+std::uint64_t crc_engine::value() const noexcept {
+  const auto out = params_.refout ? reg_ : reflected(reg_, params_.width);
+  return (out ^ params_.xorout) &
+         detail::low_mask<std::uint64_t>(params_.width);
+}
+
+std::uint64_t crc(const crc_params &params, bit_view bits) {
+  return crc_engine(params)(bits);
+}
+
+} // namespace bitstring
@@ -0,0 +1,91 @@
+#include "bitstring/hash.hpp"
+#include "bitstring/bit_ops.hpp"
+
+#include <algorithm>
+
+namespace bitstring {
+
+namespace {
+constexpr std::uint64_t secret0 = 0xa0761d6478bd642fULL;
+constexpr std::uint64_t secret1 = 0xe7037ed1a0b428dbULL;
+constexpr std::uint64_t secret2 = 0x8ebc6af09c88c6e3ULL;
+constexpr std::uint64_t secret3 = 0x589965cc75374cc3ULL;
+constexpr std::size_t word_bits = 64;
+
+// xor of the high and low half of the 128 bit product
+std::uint64_t mix(std::uint64_t a, std::uint64_t b) noexcept {
+#ifdef __SIZEOF_INT128__
+  __extension__ using u128 = unsigned __int128;
+  const auto r = static_cast<u128>(a) * b;
+  return static_cast<std::uint64_t>(r) ^ static_cast<std::uint64_t>(r >> 64U);
+#else
+  const auto a_lo = a & 0xffffffffULL;
+  const auto a_hi = a >> 32U;
+  const auto b_lo = b & 0xffffffffULL;
+  const auto b_hi = b >> 32U;
+  const auto lo_lo = a_lo * b_lo;
+  const auto hi_lo = a_hi * b_lo;
+  const auto lo_hi = a_lo * b_hi;
+  const auto hi_hi = a_hi * b_hi;
+  const auto cross = (lo_lo >> 32U) + (hi_lo & 0xffffffffULL) + lo_hi;
+  const auto hi = hi_hi + (hi_lo >> 32U) + (cross >> 32U);
+  const auto lo = (cross << 32U) | (lo_lo & 0xffffffffULL);
+  return hi ^ lo;
+#endif
+}
+} // namespace
+
+bit_hasher &bit_hasher::reset(std::uint64_t seed) noexcept {
+  state_ = seed ^ secret0;
+  pending_ = 0;
+  has_pending_ = false;
+  acc_ = 0;
+  acc_bits_ = 0;
+  bitcnt_ = 0;
+  return *this;
+}
+
+void bit_hasher::push(std::uint64_t word) noexcept {
+  if (!has_pending_) {
+    pending_ = word;
+    has_pending_ = true;
+    return;
+  }
+  state_ = mix(pending_ ^ secret1, word ^ state_);
+  has_pending_ = false;
+}
+
+bit_hasher &bit_hasher::update(bit_view bits) noexcept {
+  bitcnt_ += bits.size();
+  std::size_t pos = 0;
+  if (acc_bits_ != 0) {
+    pos = std::min(word_bits - acc_bits_, bits.size());
+    acc_ |= detail::load_u64(bits.data(), bits.offset(), pos) << acc_bits_;
+    acc_bits_ += pos;
+    if (acc_bits_ != word_bits) {
+      return *this;
+    }
+    push(acc_);
+    acc_ = 0;
+    acc_bits_ = 0;
+  }
+  for (; bits.size() - pos >= word_bits; pos += word_bits) {
+    push(detail::load_u64(bits.data(), bits.offset() + pos, word_bits));
+  }
+  acc_bits_ = bits.size() - pos;
+  acc_ = detail::load_u64(bits.data(), bits.offset() + pos, acc_bits_);
+  return *this;
+}
+
+std::uint64_t bit_hasher::digest() const noexcept {
+  const auto first = has_pending_ ? pending_ : acc_;
+  const auto second = has_pending_ ? acc_ : 0;
+  const auto state = mix(first ^ secret1, second ^ state_ ^ secret2);
+  return mix(state ^ secret0, bitcnt_ ^ secret3);
+}
+
+std::uint64_t hash(bit_view bits, std::uint64_t seed) noexcept {
+  return bit_hasher(seed).update(bits).digest();
+}
+
+} // namespace bitstring
@@ -0,0 +1,259 @@
+#include "bitstring/integer_codes.hpp"
+#include "bitstring/bit_ops.hpp"
+#include "bitstring/endian.hpp"
+#include "bitstring/exceptions.hpp"
+
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace bitstring {
+
+namespace {
+constexpr std::size_t max_bits = 64;
+constexpr std::size_t max_leb128_bytes = 10;
+constexpr std::uint64_t leb128_payload = 0x7f7f'7f7f'7f7f'7f7fULL;
+constexpr std::uint64_t leb128_continue = 0x8080'8080'8080'8080ULL;
+
+std::size_t bit_width(std::uint64_t v) noexcept {
+  return v == 0 ? 0 : max_bits - detail::countl_zero(v);
+}
+
+// the low n bits of v in reverse order, for MSB first fields
+std::uint64_t reversed(std::uint64_t v, std::size_t n) noexcept {
+  return n == 0 ? 0 : detail::bitflipped(v) >> (max_bits - n);
+}
+
+void check_parameter(std::size_t k) {
+  if (k >= max_bits) {
+    throw std::out_of_range("code parameter must be < 64");
+  }
+}
+
+void write_zeros(bit_writer &out, std::uint64_t n) {
+  for (; n > max_bits; n -= max_bits) {
+    out.write(0, max_bits);
+  }
+  out.write(0, n);
+}
+
+// length of a run of zeros terminated by a one, which is consumed as well
+std::uint64_t read_unary(bit_reader &in) {
+  std::uint64_t zeros = 0;
+  for (;;) {
+    const auto window = in.peek(max_bits);
+    if (window != 0) {
+      const auto z = detail::countr_zero(window);
+      if (z >= in.remaining()) {
+        break;
+      }
+      in.skip(z + 1);
+      return zeros + z;
+    }
+    if (in.remaining() <= max_bits) {
+      break;
+    }
+    in.skip(max_bits);
+    zeros += max_bits;
+  }
+  throw decode_error("truncated integer code");
+}
+
+std::uint64_t read_msb_first(bit_reader &in, std::size_t n) {
+  return reversed(in.read(n), n);
+}
+
+void encode_exp_golomb(bit_writer &out, std::uint64_t v, std::size_t k) {
+  const auto base = std::uint64_t{1} << k;
+  if (v > std::numeric_limits<std::uint64_t>::max() - base) {
+    throw std::out_of_range("value too large for exp-golomb code");
+  }
+  const auto x = v + base;
+  const auto n = bit_width(x);
+  out.write(0, n - 1 - k);
+  out.write(reversed(x, n), n);
+}
+
+std::uint64_t decode_exp_golomb(bit_reader &in, std::size_t k) {
+  const auto zeros = read_unary(in);
+  if (zeros + k >= max_bits) {
+    throw decode_error("exp-golomb code exceeds 64 bits");
+  }
+  // the leading one was consumed with the prefix
+  const auto rest = zeros + k;
+  const auto x = (std::uint64_t{1} << rest) | read_msb_first(in, rest);
+  return x - (std::uint64_t{1} << k);
+}
+
+void encode_elias_delta(bit_writer &out, std::uint64_t v) {
+  const auto n = bit_width(v);
+  encode_exp_golomb(out, n - 1, 0);
+  out.write(reversed(v, n - 1), n - 1);
+}
+
+std::uint64_t decode_elias_delta(bit_reader &in) {
+  // the bit width minus one, which is the number of bits that follow
+  const auto low = decode_exp_golomb(in, 0);
+  if (low >= max_bits) {
+    throw decode_error("elias delta code exceeds 64 bits");
+  }
+  return (std::uint64_t{1} << low) | read_msb_first(in, low);
+}
+
+void encode_rice(bit_writer &out, std::uint64_t v, std::size_t k) {
+  write_zeros(out, v >> k);
+  out.write(1, 1);
+  out.write(reversed(v, k), k);
+}
+
+std::uint64_t decode_rice(bit_reader &in, std::size_t k) {
+  const auto q = read_unary(in);
+  if (k != 0 && (q >> (max_bits - k)) != 0) {
+    throw decode_error("rice code exceeds 64 bits");
+  }
+  return (q << k) | read_msb_first(in, k);
+}
+
+void encode_leb128(bit_writer &out, std::uint64_t v) {
+  for (; v >= 0x80U; v >>= 7U) {
+    out.write((v & 0x7fU) | 0x80U, 8);
+  }
+  out.write(v, 8);
+}
+
+std::uint64_t decode_leb128(bit_reader &in) {
+  // up to 8 bytes at once: the first clear continuation bit ends the value
+  const auto window = in.peek(max_bits);
+  const auto ends = ~window & leb128_continue;
+  if (ends != 0) {
+    const auto bytes = detail::countr_zero(ends) / 8 + 1;
+    if (bytes * 8 > in.remaining()) {
+      throw decode_error("truncated integer code");
+    }
+    in.skip(bytes * 8);
+    return detail::pext(window & detail::low_mask<std::uint64_t>(bytes * 8),
+                        leb128_payload);
+  }
+  std::uint64_t v = 0;
+  for (std::size_t i = 0; i < max_leb128_bytes; i++) {
+    if (in.remaining() < 8) {
+      throw decode_error("truncated integer code");
+    }
+    const auto byte = in.read(8);
+    v |= (byte & 0x7fU) << (7 * i);
+    if ((byte & 0x80U) == 0) {
+      if (i == max_leb128_bytes - 1 && byte > 1) {
+        break;
+      }
+      return v;
+    }
+  }
+  throw decode_error("leb128 value exceeds 64 bits");
+}
+
+template <integer_code Code>
+std::uint64_t decode_one(bit_reader &in, std::size_t k) {
+  if constexpr (Code == integer_code::exp_golomb) {
+    return decode_exp_golomb(in, k);
+  } else if constexpr (Code == integer_code::elias_gamma) {
+    return decode_exp_golomb(in, 0) + 1;
+  } else if constexpr (Code == integer_code::elias_delta) {
+    return decode_elias_delta(in);
+  } else if constexpr (Code == integer_code::rice) {
+    return decode_rice(in, k);
+  } else {
+    return decode_leb128(in);
+  }
+}
+
+// the code is dispatched once per batch, not per value
+template <integer_code Code>
+std::size_t decode_batch(bit_reader &in, std::uint64_t *out,
+                         std::size_t count, std::size_t k) {
+  std::size_t i = 0;
+  for (; i < count && !in.empty(); i++) {
+    out[i] = decode_one<Code>(in, k);
+  }
+  return i;
+}
+} // namespace
+
+void encode_integer(bit_writer &out, std::uint64_t v, integer_code code,
+                    std::size_t k) {
+  check_parameter(k);
+  switch (code) {
+  case integer_code::exp_golomb:
+    encode_exp_golomb(out, v, k);
+    break;
+  case integer_code::elias_gamma:
+  case integer_code::elias_delta:
+    if (v == 0) {
+      throw std::out_of_range("elias codes start at 1");
+    }
+    if (code == integer_code::elias_gamma) {
+      encode_exp_golomb(out, v - 1, 0);
+    } else {
+      encode_elias_delta(out, v);
+    }
+    break;
+  case integer_code::rice:
+    encode_rice(out, v, k);
+    break;
+  case integer_code::leb128:
+    encode_leb128(out, v);
+    break;
+  }
+}
+
+std::uint64_t decode_integer(bit_reader &in, integer_code code,
+                             std::size_t k) {
+  std::uint64_t v = 0;
+  if (decode_integers(in, &v, 1, code, k) == 0) {
+    throw decode_error("truncated integer code");
+  }
+  return v;
+}
+
+std::size_t decode_integers(bit_reader &in, std::uint64_t *out,
+                            std::size_t count, integer_code code,
+                            std::size_t k) {
+  check_parameter(k);
+  switch (code) {
+  case integer_code::exp_golomb:
+    return decode_batch<integer_code::exp_golomb>(in, out, count, k);
+  case integer_code::elias_gamma:
+    return decode_batch<integer_code::elias_gamma>(in, out, count, k);
+  case integer_code::elias_delta:
+    return decode_batch<integer_code::elias_delta>(in, out, count, k);
+  case integer_code::rice:
+    return decode_batch<integer_code::rice>(in, out, count, k);
+  case integer_code::leb128:
+    return decode_batch<integer_code::leb128>(in, out, count, k);
+  }
+  return 0;
+}
+
+bit_array encode_integers(const std::vector<std::uint64_t> &values,
+                          integer_code code, std::size_t k) {
+  bit_writer out;
+  for (const auto v : values) {
+    encode_integer(out, v, code, k);
+  }
+  return out.finish();
+}
+
+std::vector<std::uint64_t> decode_integers(bit_view bits, integer_code code,
+                                           std::size_t k) {
+  std::vector<std::uint64_t> ret;
+  bit_reader in(bits);
+  std::uint64_t buffer[64];
+  for (;;) {
+    const auto n = decode_integers(in, buffer, std::size(buffer), code, k);
+    ret.insert(ret.end(), buffer, buffer + n);
+    if (n < std::size(buffer)) {
+      return ret;
+    }
+  }
+}
+
+} // namespace bitstring
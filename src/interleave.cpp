@@ -0,0 +1,118 @@
+#include "bitstring/interleave.hpp"
+#include "bitstring/bit_ops.hpp"
+#include "bitstring/bit_stream.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace bitstring {
+
+namespace {
+using storage_type = bit_view::storage_type;
+constexpr std::size_t block = 8;
+constexpr std::size_t byte_bits = 8;
+
+#ifdef __SSE2__
+// 8 lanes from a byte aligned source: the high bits of 16 samples at once,
+// shifting lane l into the high bit first
+void deinterleave8_sse2(const unsigned char *src, std::size_t samples,
+                        std::vector<bit_writer> &out) {
+  for (std::size_t t = 0; t + 16 <= samples; t += 16) {
+    const auto v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + t));
+    for (std::size_t l = 0; l < block; l++) {
+      const auto shifted = _mm_slli_epi64(v, static_cast<int>(7 - l));
+      out[l].write(static_cast<unsigned int>(_mm_movemask_epi8(shifted)), 16);
+    }
+  }
+}
+#endif
+} // namespace
+
+std::vector<bit_array> deinterleave(bit_view source, std::size_t lanes) {
+  if (lanes == 0 || source.size() % lanes != 0) {
+    throw std::invalid_argument("lanes must divide the number of bits");
+  }
+  const auto samples = source.size() / lanes;
+  std::vector<bit_writer> out;
+  out.reserve(lanes);
+  for (std::size_t l = 0; l < lanes; l++) {
+    out.emplace_back(samples);
+  }
+
+  std::size_t t = 0;
+#ifdef __SSE2__
+  // x86 is little endian, so the storage units can be read as bytes
+  if (lanes == block && source.offset() % byte_bits == 0) {
+    const auto src = reinterpret_cast<const unsigned char *>(source.data()) +
+                     source.offset() / byte_bits;
+    deinterleave8_sse2(src, samples, out);
+    t = samples - samples % 16;
+  }
+#endif
+
+  for (; t < samples; t += block) {
+    const auto rows = std::min(block, samples - t);
+    for (std::size_t group = 0; group < lanes; group += block) {
+      const auto width = std::min(block, lanes - group);
+      std::uint64_t matrix = 0;
+      for (std::size_t r = 0; r < rows; r++) {
+        const auto bits = source.bits((t + r) * lanes + group, width);
+        matrix |= static_cast<std::uint64_t>(bits) << (byte_bits * r);
+      }
+      matrix = detail::transpose8(matrix);
+      for (std::size_t l = 0; l < width; l++) {
+        out[group + l].write(matrix >> (byte_bits * l), rows);
+      }
+    }
+  }
+
+  std::vector<bit_array> ret;
+  ret.reserve(lanes);
+  for (auto &w : out) {
+    ret.push_back(w.finish());
+  }
+  return ret;
+}
+
+bit_array interleave(const std::vector<bit_view> &lanes) {
+  if (lanes.empty()) {
+    return bit_array();
+  }
+  const auto samples = lanes.front().size();
+  if (std::any_of(lanes.begin(), lanes.end(),
+                  [samples](bit_view l) { return l.size() != samples; })) {
+    throw std::invalid_argument("all lanes must have the same size");
+  }
+  const auto cnt = lanes.size();
+  std::vector<storage_type> units(bit_array::storage_units(samples * cnt));
+
+  for (std::size_t t = 0; t < samples; t += block) {
+    const auto rows = std::min(block, samples - t);
+    for (std::size_t group = 0; group < cnt; group += block) {
+      const auto width = std::min(block, cnt - group);
+      std::uint64_t matrix = 0;
+      for (std::size_t l = 0; l < width; l++) {
+        const auto bits = lanes[group + l].bits(t, rows);
+        matrix |= static_cast<std::uint64_t>(bits) << (byte_bits * l);
+      }
+      matrix = detail::transpose8(matrix);
+      for (std::size_t r = 0; r < rows; r++) {
+        detail::store_bits(units.data(), (t + r) * cnt + group,
+                           static_cast<storage_type>(matrix >> (byte_bits * r)),
+                           width);
+      }
+    }
+  }
+  return bit_array(std::move(units), samples * cnt);
+}
+
+bit_array interleave(const std::vector<bit_array> &lanes) {
+  return interleave(std::vector<bit_view>(lanes.begin(), lanes.end()));
+}
+
+} // namespace bitstring
@@ -0,0 +1,80 @@
+#include "bitstring/lfsr.hpp"
+#include "bitstring/bit_ops.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace bitstring {
+
+lfsr::lfsr(std::uint64_t taps, std::uint64_t state) : degree_(0), step_(64) {
+  for (unsigned int t = 1; t < 64; t++) {
+    if (((taps >> (t - 1)) & 1U) != 0) {
+      taps_.push_back(t);
+      degree_ = t;
+      step_ = std::min(step_, t);
+    }
+  }
+  if (taps_.empty() || (taps >> 63U) != 0) {
+    throw std::invalid_argument("LFSR taps must be within 1..63");
+  }
+  // keep room to add one step to a pending unit in the 64 bit buffer
+  step_ = std::min(step_, 32U);
+  state_ = state & detail::low_mask<std::uint64_t>(degree_);
+}
+
+void lfsr::refill() noexcept {
+  const auto mask = detail::low_mask<std::uint64_t>(step_);
+  while (pending_bits_ < detail::word_bits<bit_array::storage_type>) {
+    std::uint64_t next = 0;
+    for (auto t : taps_) {
+      next ^= state_ >> (degree_ - t);
+    }
+    next &= mask;
+    state_ = (state_ >> step_) | (next << (degree_ - step_));
+    pending_ |= next << pending_bits_;
+    pending_bits_ += step_;
+  }
+}
+
+bit_array::storage_type lfsr::next_bits(std::size_t n) noexcept {
+  refill();
+  const auto ret = static_cast<bit_array::storage_type>(
+      pending_ & detail::low_mask<std::uint64_t>(n));
+  pending_ = n < 64 ? pending_ >> n : 0;
+  pending_bits_ -= n;
+  return ret;
+}
+
+bit_array lfsr::generate(std::size_t bits) {
+  constexpr auto unit_bits = detail::word_bits<bit_array::storage_type>;
+  std::vector<bit_array::storage_type> units(
+      bit_array::storage_units(bits));
+  for (std::size_t i = 0; i < units.size(); i++) {
+    units[i] = next_bits(std::min(unit_bits, bits - i * unit_bits));
+  }
+  return bit_array(std::move(units), bits);
+}
+
+bit_array lfsr::scramble(bit_view data) {
+  constexpr auto unit_bits = detail::word_bits<bit_array::storage_type>;
+  std::vector<bit_array::storage_type> units(
+      bit_array::storage_units(data.size()));
+  for (std::size_t i = 0; i < units.size(); i++) {
+    const auto n = std::min(unit_bits, data.size() - i * unit_bits);
+    units[i] = data.bits(i * unit_bits, n) ^ next_bits(n);
+  }
+  return bit_array(std::move(units), data.size());
+}
+
+lfsr prbs7(std::uint64_t state) { return lfsr((1U << 6) | (1U << 5), state); }
+
+lfsr prbs15(std::uint64_t state) {
+  return lfsr((1U << 14) | (1U << 13), state);
+}
+
+lfsr prbs31(std::uint64_t state) {
+  return lfsr((1U << 30) | (1U << 27), state);
+}
+
+} // namespace bitstring
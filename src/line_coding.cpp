@@ -0,0 +1,302 @@
+#include "bitstring/line_coding.hpp"
+#include "bitstring/bit_ops.hpp"
+#include "bitstring/exceptions.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace bitstring {
+
+namespace {
+constexpr std::size_t byte_bits = 8;
+constexpr std::size_t unit_bits = detail::word_bits<bit_array::storage_type>;
+
+// Stuffing state machines, one bit at a time. They define the behavior and
+// are used to build the byte tables as well as for the trailing bits.
+//
+// stuffing state: length of the current run (0..4), for CAN + 5 * run value
+// unstuffing state: run length (0..5, 5 = next bit is a stuff bit),
+// for CAN + 6 * run value
+constexpr std::size_t stuff_states = 10;
+constexpr std::size_t unstuff_states = 12;
+constexpr unsigned int stuff_run = 5;
+
+struct step_result {
+  std::uint8_t next;
+  bool error;
+};
+
+step_result stuff_step(stuffing mode, std::uint8_t state, bool bit,
+                       std::uint16_t &out, std::uint8_t &len) {
+  out = static_cast<std::uint16_t>(out | (bit ? 1U << len : 0U));
+  len++;
+  if (mode == stuffing::hdlc) {
+    unsigned int run = bit ? state + 1U : 0U;
+    if (run == stuff_run) {
+      len++; // stuffed 0
+      run = 0;
+    }
+    return {static_cast<std::uint8_t>(run), false};
+  }
+  unsigned int run = state % stuff_run;
+  bool last = state >= stuff_run;
+  if (run != 0 && bit == last) {
+    run++;
+  } else {
+    last = bit;
+    run = 1;
+  }
+  if (run == stuff_run) {
+    last = !last;
+    out = static_cast<std::uint16_t>(out | (last ? 1U << len : 0U));
+    len++;
+    run = 1;
+  }
+  return {static_cast<std::uint8_t>(run + (last ? stuff_run : 0U)), false};
+}
+
+step_result unstuff_step(stuffing mode, std::uint8_t state, bool bit,
+                         std::uint16_t &out, std::uint8_t &len) {
+  constexpr unsigned int run_states = stuff_run + 1;
+  unsigned int run = state % run_states;
+  bool last = state >= run_states;
+  if (run == stuff_run) {
+    const bool expected = mode == stuffing::hdlc ? false : !last;
+    if (bit != expected) {
+      return {state, true};
+    }
+    run = mode == stuffing::hdlc ? 0 : 1;
+    last = bit;
+  } else {
+    out = static_cast<std::uint16_t>(out | (bit ? 1U << len : 0U));
+    len++;
+    if (mode == stuffing::hdlc) {
+      run = bit ? run + 1 : 0;
+    } else if (run != 0 && bit == last) {
+      run++;
+    } else {
+      last = bit;
+      run = 1;
+    }
+  }
+  if (mode == stuffing::hdlc) {
+    return {static_cast<std::uint8_t>(run), false};
+  }
+  return {static_cast<std::uint8_t>(run + (last ? run_states : 0U)), false};
+}
+
+struct table_entry {
+  std::uint16_t bits;
+  std::uint8_t len;
+  std::uint8_t next;
+  bool error;
+};
+
+template <std::size_t States>
+using byte_table = std::array<std::array<table_entry, 256>, States>;
+
+template <std::size_t States, typename Step>
+byte_table<States> build_table(stuffing mode, Step step) {
+  byte_table<States> table{};
+  for (std::uint8_t state = 0; state < States; state++) {
+    for (unsigned int byte = 0; byte < 256; byte++) {
+      table_entry e{0, 0, state, false};
+      for (std::size_t b = 0; b < byte_bits && !e.error; b++) {
+        const auto r = step(mode, e.next, ((byte >> b) & 1U) != 0, e.bits,
+                            e.len);
+        e.next = r.next;
+        e.error = r.error;
+      }
+      table[state][byte] = e;
+    }
+  }
+  return table;
+}
+
+const byte_table<stuff_states> &stuff_table(stuffing mode) {
+  static const std::array<byte_table<stuff_states>, 2> tables{
+      build_table<stuff_states>(stuffing::hdlc, stuff_step),
+      build_table<stuff_states>(stuffing::can, stuff_step)};
+  return tables[mode == stuffing::hdlc ? 0 : 1];
+}
+
+const byte_table<unstuff_states> &unstuff_table(stuffing mode) {
+  static const std::array<byte_table<unstuff_states>, 2> tables{
+      build_table<unstuff_states>(stuffing::hdlc, unstuff_step),
+      build_table<unstuff_states>(stuffing::can, unstuff_step)};
+  return tables[mode == stuffing::hdlc ? 0 : 1];
+}
+
+template <std::size_t States, typename Step>
+std::uint8_t run_table(const byte_table<States> &table, stuffing mode,
+                       Step step, std::uint8_t state, bit_view in,
+                       bit_writer &out) {
+  std::size_t pos = 0;
+  for (; in.size() - pos >= byte_bits; pos += byte_bits) {
+    const auto &e = table[state][in.bits(pos, byte_bits)];
+    if (e.error) {
+      throw decode_error("invalid stuff bit");
+    }
+    out.write(e.bits, e.len);
+    state = e.next;
+  }
+  for (; pos < in.size(); pos++) {
+    std::uint16_t bits = 0;
+    std::uint8_t len = 0;
+    const auto r = step(mode, state, in[pos] != 0, bits, len);
+    if (r.error) {
+      throw decode_error("invalid stuff bit");
+    }
+    out.write(bits, len);
+    state = r.next;
+  }
+  return state;
+}
+
+// bit i of the index at bit 2i
+constexpr std::array<std::uint16_t, 256> spread_table() {
+  std::array<std::uint16_t, 256> ret{};
+  for (unsigned int i = 0; i < 256; i++) {
+    unsigned int v = 0;
+    for (unsigned int b = 0; b < byte_bits; b++) {
+      v |= ((i >> b) & 1U) << (2 * b);
+    }
+    ret[i] = static_cast<std::uint16_t>(v);
+  }
+  return ret;
+}
+constexpr auto spread = spread_table();
+
+// inverse of spread for the even bits of a unit
+constexpr std::uint32_t compress_even(std::uint32_t x) noexcept {
+  x &= 0x55555555U;
+  x = (x | (x >> 1U)) & 0x33333333U;
+  x = (x | (x >> 2U)) & 0x0f0f0f0fU;
+  x = (x | (x >> 4U)) & 0x00ff00ffU;
+  x = (x | (x >> 8U)) & 0x0000ffffU;
+  return x;
+}
+
+constexpr std::uint32_t prefix_xor(std::uint32_t x) noexcept {
+  x ^= x << 1U;
+  x ^= x << 2U;
+  x ^= x << 4U;
+  x ^= x << 8U;
+  x ^= x << 16U;
+  return x;
+}
+} // namespace
+
+void stuffer::operator()(bit_view in, bit_writer &out) {
+  state_ = run_table(stuff_table(mode_), mode_, stuff_step, state_, in, out);
+}
+
+void unstuffer::operator()(bit_view in, bit_writer &out) {
+  state_ =
+      run_table(unstuff_table(mode_), mode_, unstuff_step, state_, in, out);
+}
+
+bit_array stuff(bit_view in, stuffing mode) {
+  bit_writer out(in.size() + in.size() / 4);
+  stuffer{mode}(in, out);
+  return out.finish();
+}
+
+bit_array unstuff(bit_view in, stuffing mode) {
+  bit_writer out(in.size());
+  unstuffer{mode}(in, out);
+  return out.finish();
+}
+
+void manchester_encode(bit_view in, bit_writer &out, manchester convention) {
+  constexpr std::size_t chunk = unit_bits / 2;
+  for (std::size_t pos = 0; pos < in.size(); pos += chunk) {
+    const auto n = std::min(chunk, in.size() - pos);
+    const auto v = in.bits(pos, n);
+    const auto ones = static_cast<std::uint32_t>(spread[v & 0xffU]) |
+                      static_cast<std::uint32_t>(spread[(v >> 8U) & 0xffU])
+                          << 16U;
+    const auto not_v = ~v;
+    const auto complement =
+        static_cast<std::uint32_t>(spread[not_v & 0xffU]) |
+        static_cast<std::uint32_t>(spread[(not_v >> 8U) & 0xffU]) << 16U;
+    const auto encoded = convention == manchester::ieee_802_3
+                             ? (ones << 1U) | complement
+                             : ones | (complement << 1U);
+    out.write(encoded, 2 * n);
+  }
+}
+
+void manchester_decode(bit_view in, bit_writer &out, manchester convention) {
+  if (in.size() % 2 != 0) {
+    throw decode_error("manchester code must have an even number of bits");
+  }
+  for (std::size_t pos = 0; pos < in.size(); pos += unit_bits) {
+    const auto n = std::min(unit_bits, in.size() - pos);
+    const auto v = in.bits(pos, n);
+    const auto first = v & 0x55555555U;
+    const auto second = (v >> 1U) & 0x55555555U;
+    const auto pairs = detail::low_mask<std::uint32_t>(n) & 0x55555555U;
+    if ((first ^ second) != pairs) {
+      throw decode_error("manchester symbol without transition");
+    }
+    out.write(compress_even(convention == manchester::ieee_802_3 ? second
+                                                                 : first),
+              n / 2);
+  }
+}
+
+bit_array manchester_encode(bit_view in, manchester convention) {
+  bit_writer out(2 * in.size());
+  manchester_encode(in, out, convention);
+  return out.finish();
+}
+
+bit_array manchester_decode(bit_view in, manchester convention) {
+  bit_writer out(in.size() / 2);
+  manchester_decode(in, out, convention);
+  return out.finish();
+}
+
+void nrzi_encoder::operator()(bit_view in, bit_writer &out) {
+  for (std::size_t pos = 0; pos < in.size(); pos += unit_bits) {
+    const auto n = std::min(unit_bits, in.size() - pos);
+    auto transitions = in.bits(pos, n);
+    if (mode_ == nrzi::transition_on_zero) {
+      transitions = ~transitions;
+    }
+    auto levels = prefix_xor(transitions & detail::low_mask<std::uint32_t>(n));
+    if (level_) {
+      levels = ~levels;
+    }
+    out.write(levels, n);
+    level_ = ((levels >> (n - 1)) & 1U) != 0;
+  }
+}
+
+void nrzi_decoder::operator()(bit_view in, bit_writer &out) {
+  for (std::size_t pos = 0; pos < in.size(); pos += unit_bits) {
+    const auto n = std::min(unit_bits, in.size() - pos);
+    const auto levels = in.bits(pos, n);
+    auto bits = levels ^ ((levels << 1U) | (level_ ? 1U : 0U));
+    if (mode_ == nrzi::transition_on_zero) {
+      bits = ~bits;
+    }
+    out.write(bits, n);
+    level_ = ((levels >> (n - 1)) & 1U) != 0;
+  }
+}
+
+bit_array nrzi_encode(bit_view in, nrzi mode, bool level) {
+  bit_writer out(in.size());
+  nrzi_encoder{mode, level}(in, out);
+  return out.finish();
+}
+
+bit_array nrzi_decode(bit_view in, nrzi mode, bool level) {
+  bit_writer out(in.size());
+  nrzi_decoder{mode, level}(in, out);
+  return out.finish();
+}
+
+} // namespace bitstring
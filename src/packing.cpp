@@ -0,0 +1,138 @@
+#include "bitstring/packing.hpp"
+#include "bitstring/bit_ops.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <utility>
+
+namespace bitstring {
+
+namespace {
+using storage_type = bit_view::storage_type;
+constexpr std::size_t unit_bits = detail::word_bits<storage_type>;
+constexpr std::size_t max_width = 64;
+
+template <std::size_t W> std::uint64_t reversed(std::uint64_t v) noexcept {
+  return detail::bitflipped(v) >> (max_width - W);
+}
+
+template <typename T, std::size_t W>
+void pack_kernel(const T *values, std::size_t count, bool msb,
+                 storage_type *out) {
+  std::uint64_t acc = 0;
+  std::size_t fill = 0;
+  // n <= unit_bits, so acc never holds more than 64 bits
+  const auto put = [&](std::uint64_t v, std::size_t n) {
+    acc |= v << fill;
+    fill += n;
+    if (fill >= unit_bits) {
+      *out++ = static_cast<storage_type>(acc);
+      acc >>= unit_bits;
+      fill -= unit_bits;
+    }
+  };
+  for (std::size_t i = 0; i < count; i++) {
+    std::uint64_t v = values[i];
+    v = msb ? reversed<W>(v) : v & detail::low_mask<std::uint64_t>(W);
+    if constexpr (W > unit_bits) {
+      put(v & detail::low_mask<std::uint64_t>(unit_bits), unit_bits);
+      put(v >> unit_bits, W - unit_bits);
+    } else {
+      put(v, W);
+    }
+  }
+  if (fill != 0) {
+    *out = static_cast<storage_type>(acc);
+  }
+}
+
+template <typename T, std::size_t W>
+void unpack_kernel(bit_view bits, bool msb, T *out) {
+  std::uint64_t buf = 0;
+  std::size_t have = 0;
+  std::size_t pos = 0;
+  // n <= unit_bits, refills a storage unit at a time
+  const auto take = [&](std::size_t n) {
+    if (have < n) {
+      const auto k = std::min(unit_bits, bits.size() - pos);
+      buf |= static_cast<std::uint64_t>(bits.bits(pos, k)) << have;
+      have += k;
+      pos += k;
+    }
+    const auto v = buf & detail::low_mask<std::uint64_t>(n);
+    buf >>= n;
+    have -= n;
+    return v;
+  };
+  const auto count = bits.size() / W;
+  for (std::size_t i = 0; i < count; i++) {
+    std::uint64_t v = 0;
+    if constexpr (W > unit_bits) {
+      v = take(unit_bits);
+      v |= take(W - unit_bits) << unit_bits;
+    } else {
+      v = take(W);
+    }
+    out[i] = static_cast<T>(msb ? reversed<W>(v) : v);
+  }
+}
+
+template <typename T>
+using pack_fn = void (*)(const T *, std::size_t, bool, storage_type *);
+template <typename T> using unpack_fn = void (*)(bit_view, bool, T *);
+
+template <typename T, std::size_t... I>
+constexpr std::array<pack_fn<T>, sizeof...(I)>
+pack_kernels(std::index_sequence<I...> /*unused*/) {
+  return {&pack_kernel<T, I + 1>...};
+}
+template <typename T, std::size_t... I>
+constexpr std::array<unpack_fn<T>, sizeof...(I)>
+unpack_kernels(std::index_sequence<I...> /*unused*/) {
+  return {&unpack_kernel<T, I + 1>...};
+}
+
+template <typename T> void check_width(std::size_t width) {
+  if (width == 0 || width > 8 * sizeof(T)) {
+    throw std::invalid_argument("width must be 1 to the bits of the type");
+  }
+}
+} // namespace
+
+template <typename T>
+bit_array pack(const T *values, std::size_t count, std::size_t width,
+               bitorder bio) {
+  check_width<T>(width);
+  static constexpr auto kernels =
+      pack_kernels<T>(std::make_index_sequence<8 * sizeof(T)>());
+  std::vector<storage_type> units(bit_array::storage_units(count * width));
+  kernels[width - 1](values, count, bio == bitorder::msb_first, units.data());
+  return bit_array(std::move(units), count * width);
+}
+
+template <typename T>
+void unpack(bit_view bits, std::size_t width, T *out, bitorder bio) {
+  check_width<T>(width);
+  if (bits.size() % width != 0) {
+    throw std::invalid_argument("width must divide the number of bits");
+  }
+  static constexpr auto kernels =
+      unpack_kernels<T>(std::make_index_sequence<8 * sizeof(T)>());
+  kernels[width - 1](bits, bio == bitorder::msb_first, out);
+}
+
+template bit_array pack(const std::uint8_t *, std::size_t, std::size_t,
+                        bitorder);
+template bit_array pack(const std::uint16_t *, std::size_t, std::size_t,
+                        bitorder);
+template bit_array pack(const std::uint32_t *, std::size_t, std::size_t,
+                        bitorder);
+template bit_array pack(const std::uint64_t *, std::size_t, std::size_t,
+                        bitorder);
+template void unpack(bit_view, std::size_t, std::uint8_t *, bitorder);
+template void unpack(bit_view, std::size_t, std::uint16_t *, bitorder);
+template void unpack(bit_view, std::size_t, std::uint32_t *, bitorder);
+template void unpack(bit_view, std::size_t, std::uint64_t *, bitorder);
+
+} // namespace bitstring
@@ -0,0 +1,131 @@
+#include "bitstring/prefix_code.hpp"
+#include "bitstring/exceptions.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+namespace bitstring {
+
+namespace {
+constexpr std::size_t max_root_bits = 16;
+constexpr std::size_t max_code_bits = 64;
+} // namespace
+
+std::size_t prefix_code::table_bits(const std::vector<codeword> &codes) const
+    noexcept {
+  std::size_t max_length = 0;
+  for (const auto &c : codes) {
+    max_length = std::max(max_length, c.length);
+  }
+  return std::min(root_bits_, max_length);
+}
+
+prefix_code::prefix_code(
+    const std::vector<std::pair<bit_array, symbol_type>> &codes,
+    std::size_t root_bits)
+    : root_bits_(root_bits) {
+  if (root_bits == 0 || root_bits > max_root_bits) {
+    throw std::invalid_argument("root_bits must be 1 to 16");
+  }
+  std::vector<codeword> words;
+  words.reserve(codes.size());
+  for (const auto &[bits, symbol] : codes) {
+    if (bits.empty() || bits.size() > max_code_bits) {
+      throw std::invalid_argument("codewords must have 1 to 64 bits");
+    }
+    words.push_back({detail::load_u64(bits.view().data(),
+                                      bits.view().offset(), bits.size()),
+                     bits.size(), symbol});
+  }
+  first_bits_ = table_bits(words);
+  build(words);
+}
+
+// appends the table for codes (with the bits of previous levels already
+// removed) and its subtables to entries_, returns the table start
+std::size_t prefix_code::build(const std::vector<codeword> &codes) {
+  const auto bits = table_bits(codes);
+  const auto start = entries_.size();
+  if (start + (std::size_t{1} << bits) >
+      std::numeric_limits<std::uint32_t>::max()) {
+    throw std::invalid_argument("prefix code tables too large");
+  }
+  entries_.resize(start + (std::size_t{1} << bits),
+                  entry{0, 0, kind::invalid});
+
+  std::map<std::uint64_t, std::vector<codeword>> longer;
+  for (const auto &c : codes) {
+    if (c.length > bits) {
+      const auto prefix = c.bits & detail::low_mask<std::uint64_t>(bits);
+      longer[prefix].push_back(
+          {c.bits >> bits, c.length - bits, c.symbol});
+      continue;
+    }
+    // every index that starts with the codeword
+    const auto fill = std::uint64_t{1} << (bits - c.length);
+    for (std::uint64_t high = 0; high < fill; high++) {
+      auto &e = entries_[start + (c.bits | (high << c.length))];
+      if (e.type != kind::invalid) {
+        throw std::invalid_argument("codewords are not prefix free");
+      }
+      e = entry{c.symbol, static_cast<std::uint8_t>(c.length), kind::symbol};
+    }
+  }
+  for (const auto &[prefix, group] : longer) {
+    if (entries_[start + prefix].type != kind::invalid) {
+      throw std::invalid_argument("codewords are not prefix free");
+    }
+    const auto sub = build(group);
+    entries_[start + prefix] =
+        entry{static_cast<std::uint32_t>(sub),
+              static_cast<std::uint8_t>(table_bits(group)), kind::table};
+  }
+  return start;
+}
+
+prefix_code::symbol_type prefix_code::decode(bit_reader &reader) const {
+  std::size_t table = 0;
+  std::size_t bits = first_bits_;
+  for (;;) {
+    const auto &e = entries_[table + reader.peek(bits)];
+    if (e.type == kind::symbol) {
+      if (e.bits > reader.remaining()) {
+        throw decode_error("truncated prefix codeword");
+      }
+      reader.skip(e.bits);
+      return e.value;
+    }
+    if (e.type == kind::invalid) {
+      throw decode_error("invalid prefix codeword");
+    }
+    // all codewords of the subtable are longer than this level
+    if (bits >= reader.remaining()) {
+      throw decode_error("truncated prefix codeword");
+    }
+    reader.skip(bits);
+    table = e.value;
+    bits = e.bits;
+  }
+}
+
+std::size_t prefix_code::decode(bit_reader &reader, symbol_type *out,
+                                std::size_t count) const {
+  std::size_t i = 0;
+  for (; i < count && !reader.empty(); i++) {
+    out[i] = decode(reader);
+  }
+  return i;
+}
+
+std::vector<prefix_code::symbol_type> prefix_code::decode(bit_view bits) const {
+  std::vector<symbol_type> ret;
+  bit_reader reader(bits);
+  while (!reader.empty()) {
+    ret.push_back(decode(reader));
+  }
+  return ret;
+}
+
+} // namespace bitstring
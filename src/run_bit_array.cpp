@@ -0,0 +1,125 @@
+#include "bitstring/run_bit_array.hpp"
+#include "bitstring/bit_ops.hpp"
+#include "bitstring/bit_stream.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace bitstring {
+
+namespace {
+using storage_type = bit_view::storage_type;
+constexpr std::size_t unit_bits = detail::word_bits<storage_type>;
+} // namespace
+
+run_bit_array::run_bit_array(bit_view bits) {
+  if (bits.empty()) {
+    return;
+  }
+  first_ = bits[0] != 0;
+  auto value = first_;
+  for (std::size_t pos = 0; pos < bits.size(); pos += unit_bits) {
+    const auto n = std::min(unit_bits, bits.size() - pos);
+    // set bits mark where the current run does not continue
+    const storage_type fill = value ? ~storage_type{0} : 0U;
+    storage_type diff =
+        (bits.bits(pos, n) ^ fill) & detail::low_mask<storage_type>(n);
+    while (diff != 0) {
+      const auto end = detail::countr_zero(diff);
+      ends_.push_back(pos + end);
+      value = !value;
+      // the next run continues while bits equal the new value
+      diff = ~diff & detail::low_mask<storage_type>(n) &
+             ~detail::low_mask<storage_type>(end);
+    }
+  }
+  ends_.push_back(bits.size());
+}
+
+bit_array run_bit_array::to_bit_array() const {
+  bit_writer out(size());
+  bitcnt_t pos = 0;
+  for (std::size_t i = 0; i < ends_.size(); i++) {
+    const std::uint64_t fill = run_value(i) ? ~std::uint64_t{0} : 0;
+    for (; ends_[i] - pos >= 64; pos += 64) {
+      out.write(fill, 64);
+    }
+    out.write(fill, ends_[i] - pos);
+    pos = ends_[i];
+  }
+  return out.finish();
+}
+
+uint8_t run_bit_array::operator[](bitcnt_t idx) const noexcept {
+  const auto it = std::upper_bound(ends_.begin(), ends_.end(), idx);
+  return run_value(static_cast<std::size_t>(it - ends_.begin())) ? 1 : 0;
+}
+
+run_bit_array::bitcnt_t run_bit_array::count() const noexcept {
+  bitcnt_t cnt = 0;
+  for (std::size_t i = first_ ? 0 : 1; i < ends_.size(); i += 2) {
+    cnt += ends_[i] - (i == 0 ? 0 : ends_[i - 1]);
+  }
+  return cnt;
+}
+
+run_bit_array &run_bit_array::append(bool value, bitcnt_t n) {
+  if (n == 0) {
+    return *this;
+  }
+  if (ends_.empty()) {
+    first_ = value;
+    ends_.push_back(n);
+  } else if (run_value(ends_.size() - 1) == value) {
+    ends_.back() += n;
+  } else {
+    ends_.push_back(ends_.back() + n);
+  }
+  return *this;
+}
+
+template <typename Op>
+run_bit_array run_bit_array::combine(const run_bit_array &a,
+                                     const run_bit_array &b, Op op) {
+  if (a.size() != b.size()) {
+    throw std::length_error("run_bit_array operands differ in size");
+  }
+  run_bit_array ret;
+  bitcnt_t pos = 0;
+  std::size_t i = 0;
+  std::size_t j = 0;
+  while (i < a.ends_.size() && j < b.ends_.size()) {
+    const auto end = std::min(a.ends_[i], b.ends_[j]);
+    ret.append(op(a.run_value(i), b.run_value(j)), end - pos);
+    pos = end;
+    if (a.ends_[i] == end) {
+      i++;
+    }
+    if (b.ends_[j] == end) {
+      j++;
+    }
+  }
+  return ret;
+}
+
+run_bit_array &run_bit_array::operator&=(const run_bit_array &o) {
+  return *this = combine(*this, o, [](bool x, bool y) { return x && y; });
+}
+
+run_bit_array &run_bit_array::operator|=(const run_bit_array &o) {
+  return *this = combine(*this, o, [](bool x, bool y) { return x || y; });
+}
+
+run_bit_array &run_bit_array::operator^=(const run_bit_array &o) {
+  return *this = combine(*this, o, [](bool x, bool y) { return x != y; });
+}
+
+run_bit_array run_bit_array::operator~() const {
+  auto ret = *this;
+  if (!ret.empty()) {
+    ret.first_ = !ret.first_;
+  }
+  return ret;
+}
+
+} // namespace bitstring
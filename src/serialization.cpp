@@ -0,0 +1,320 @@
+#include "bitstring/serialization.hpp"
+#include "bitstring/bit_ops.hpp"
+#include "bitstring/exceptions.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+namespace bitstring {
+
+namespace {
+using storage_type = bit_view::storage_type;
+constexpr std::size_t unit_bits = detail::word_bits<storage_type>;
+constexpr std::size_t unit_bytes = sizeof(storage_type);
+constexpr std::size_t byte_bits = 8;
+constexpr std::size_t max_varint_bytes = 10;
+constexpr std::array<char, 4> batch_magic{'B', 'S', 'T', 'B'};
+constexpr std::size_t header_bytes = 8;
+constexpr std::size_t footer_bytes = 16;
+constexpr std::size_t buffer_bytes = 4096;
+
+bool host_little_endian() noexcept {
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+  return __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+#else
+  const storage_type probe = 1;
+  unsigned char first = 0;
+  std::memcpy(&first, &probe, 1);
+  return first == 1;
+#endif
+}
+
+std::size_t varint_size(std::uint64_t v) noexcept {
+  std::size_t n = 1;
+  for (; v >= 0x80U; v >>= 7U) {
+    n++;
+  }
+  return n;
+}
+
+template <typename Sink> void write_varint(std::uint64_t v, Sink &&sink) {
+  for (; v >= 0x80U; v >>= 7U) {
+    sink(static_cast<std::uint8_t>(v | 0x80U));
+  }
+  sink(static_cast<std::uint8_t>(v));
+}
+
+// Source returns the next byte and throws on end of input
+template <typename Source> std::uint64_t read_varint(Source &&source) {
+  std::uint64_t v = 0;
+  for (std::size_t i = 0; i < max_varint_bytes; i++) {
+    const std::uint8_t byte = source();
+    v |= static_cast<std::uint64_t>(byte & 0x7fU) << (7 * i);
+    if ((byte & 0x80U) == 0) {
+      return v;
+    }
+  }
+  throw decode_error("varint exceeds 64 bits");
+}
+
+// bytes of the record payload, a storage unit at a time
+template <typename Sink> void write_payload(bit_view bits, Sink &&sink) {
+  for (std::size_t pos = 0; pos < bits.size(); pos += unit_bits) {
+    const auto n = std::min(unit_bits, bits.size() - pos);
+    const auto unit = bits.bits(pos, n);
+    for (std::size_t b = 0; b < n; b += byte_bits) {
+      sink(static_cast<std::uint8_t>(unit >> b));
+    }
+  }
+}
+
+std::size_t payload_bytes(std::uint64_t bits) noexcept {
+  return (bits + byte_bits - 1) / byte_bits;
+}
+
+bit_array from_payload(const std::uint8_t *data, std::uint64_t bits) {
+  const auto bytes = payload_bytes(bits);
+  std::vector<storage_type> units((bytes + unit_bytes - 1) / unit_bytes);
+  for (std::size_t i = 0; i < bytes; i++) {
+    units[i / unit_bytes] |= static_cast<storage_type>(data[i])
+                             << (byte_bits * (i % unit_bytes));
+  }
+  return bit_array(std::move(units), bits);
+}
+
+std::uint64_t load_le64(const std::uint8_t *p) noexcept {
+  std::uint64_t v = 0;
+  for (std::size_t i = 0; i < sizeof(v); i++) {
+    v |= static_cast<std::uint64_t>(p[i]) << (byte_bits * i);
+  }
+  return v;
+}
+
+void store_le(std::vector<char> &out, std::uint64_t v, std::size_t bytes) {
+  for (std::size_t i = 0; i < bytes; i++) {
+    out.push_back(static_cast<char>(static_cast<std::uint8_t>(v)));
+    v >>= byte_bits;
+  }
+}
+
+struct batch_layout {
+  const std::uint8_t *data;
+  const std::uint8_t *index;
+  std::uint64_t count;
+};
+
+// validates the whole batch, including the index, such that element
+// access does not need any checks
+batch_layout parse_batch(const std::uint8_t *data, std::size_t size) {
+  if (size < header_bytes + footer_bytes ||
+      !std::equal(batch_magic.begin(), batch_magic.end(), data)) {
+    throw decode_error("not a bit_array batch");
+  }
+  if (data[batch_magic.size()] != batch_version) {
+    throw decode_error("unsupported bit_array batch version");
+  }
+  const auto footer = data + size - footer_bytes;
+  const auto count = load_le64(footer);
+  const auto words = load_le64(footer + sizeof(std::uint64_t));
+  const auto available = size - header_bytes - footer_bytes;
+  if (words > available / unit_bytes ||
+      count != (available - words * unit_bytes) / sizeof(std::uint64_t) ||
+      (available - words * unit_bytes) % sizeof(std::uint64_t) != 0) {
+    throw decode_error("inconsistent bit_array batch size");
+  }
+  const auto index = data + header_bytes + words * unit_bytes;
+  std::uint64_t prev = 0;
+  for (std::uint64_t i = 0; i < count; i++) {
+    const auto end = load_le64(index + i * sizeof(std::uint64_t));
+    if (end < prev || end > words * unit_bits) {
+      throw decode_error("corrupt bit_array batch index");
+    }
+    prev = end;
+  }
+  return {data + header_bytes, index, count};
+}
+} // namespace
+
+std::size_t serialized_size(bit_view bits) noexcept {
+  return varint_size(bits.size()) + payload_bytes(bits.size());
+}
+
+std::vector<std::uint8_t> serialize(bit_view bits) {
+  std::vector<std::uint8_t> ret;
+  ret.reserve(serialized_size(bits));
+  const auto sink = [&ret](std::uint8_t byte) { ret.push_back(byte); };
+  write_varint(bits.size(), sink);
+  write_payload(bits, sink);
+  return ret;
+}
+
+void serialize(std::ostream &os, bit_view bits) {
+  std::vector<char> buffer;
+  buffer.reserve(buffer_bytes);
+  const auto sink = [&](std::uint8_t byte) {
+    buffer.push_back(static_cast<char>(byte));
+    if (buffer.size() == buffer_bytes) {
+      os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      buffer.clear();
+    }
+  };
+  write_varint(bits.size(), sink);
+  write_payload(bits, sink);
+  os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+bit_array deserialize(const std::uint8_t *data, std::size_t size,
+                      std::size_t *consumed) {
+  std::size_t pos = 0;
+  const auto bits = read_varint([&]() {
+    if (pos == size) {
+      throw decode_error("truncated bit_array record");
+    }
+    return data[pos++];
+  });
+  const auto bytes = payload_bytes(bits);
+  if (bits > std::uint64_t{size} * byte_bits || bytes > size - pos) {
+    throw decode_error("truncated bit_array record");
+  }
+  if (consumed != nullptr) {
+    *consumed = pos + bytes;
+  }
+  return from_payload(data + pos, bits);
+}
+
+bit_array deserialize(std::istream &is) {
+  const auto bits = read_varint([&is]() {
+    const auto c = is.get();
+    if (c == std::istream::traits_type::eof()) {
+      throw decode_error("truncated bit_array record");
+    }
+    return static_cast<std::uint8_t>(c);
+  });
+  // read in bounded steps, the length is untrusted
+  std::vector<std::uint8_t> payload;
+  for (auto remaining = payload_bytes(bits); remaining != 0;) {
+    const auto n = std::min(remaining, buffer_bytes);
+    const auto old_size = payload.size();
+    payload.resize(old_size + n);
+    is.read(reinterpret_cast<char *>(payload.data() + old_size),
+            static_cast<std::streamsize>(n));
+    if (!is) {
+      throw decode_error("truncated bit_array record");
+    }
+    remaining -= n;
+  }
+  return from_payload(payload.data(), bits);
+}
+
+batch_writer::batch_writer(std::ostream &os) : os_(os) {
+  buffer_.reserve(buffer_bytes);
+  buffer_.insert(buffer_.end(), batch_magic.begin(), batch_magic.end());
+  buffer_.push_back(static_cast<char>(batch_version));
+  buffer_.resize(header_bytes, 0);
+}
+
+void batch_writer::write_word(std::uint32_t word) {
+  store_le(buffer_, word, unit_bytes);
+  words_++;
+  if (buffer_.size() >= buffer_bytes) {
+    flush();
+  }
+}
+
+void batch_writer::flush() {
+  os_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  buffer_.clear();
+}
+
+batch_writer &batch_writer::append(bit_view bits) {
+  for (std::size_t pos = 0; pos < bits.size(); pos += unit_bits) {
+    const auto n = std::min(unit_bits, bits.size() - pos);
+    acc_ |= static_cast<std::uint64_t>(bits.bits(pos, n)) << acc_bits_;
+    acc_bits_ += n;
+    if (acc_bits_ >= unit_bits) {
+      write_word(static_cast<std::uint32_t>(acc_));
+      acc_ >>= unit_bits;
+      acc_bits_ -= unit_bits;
+    }
+  }
+  bitcnt_ += bits.size();
+  ends_.push_back(bitcnt_);
+  return *this;
+}
+
+void batch_writer::finish() {
+  if (acc_bits_ != 0) {
+    write_word(static_cast<std::uint32_t>(acc_));
+    acc_ = 0;
+    acc_bits_ = 0;
+  }
+  for (const auto end : ends_) {
+    store_le(buffer_, end, sizeof(end));
+    if (buffer_.size() >= buffer_bytes) {
+      flush();
+    }
+  }
+  store_le(buffer_, ends_.size(), sizeof(std::uint64_t));
+  store_le(buffer_, words_, sizeof(std::uint64_t));
+  flush();
+}
+
+batch_view::batch_view(const void *data, std::size_t size)
+    : words_(nullptr), index_(nullptr), count_(0) {
+  if (!host_little_endian() ||
+      reinterpret_cast<std::uintptr_t>(data) % alignof(storage_type) != 0) {
+    throw std::invalid_argument(
+        "batch_view needs a 4 byte aligned buffer on a little endian host");
+  }
+  const auto layout =
+      parse_batch(static_cast<const std::uint8_t *>(data), size);
+  words_ = reinterpret_cast<const storage_type *>(layout.data);
+  index_ = layout.index;
+  count_ = layout.count;
+}
+
+std::uint64_t batch_view::end(std::size_t idx) const noexcept {
+  return load_le64(index_ + idx * sizeof(std::uint64_t));
+}
+
+bit_view batch_view::operator[](std::size_t idx) const noexcept {
+  const auto first = idx == 0 ? 0 : end(idx - 1);
+  return bit_view(words_, first, end(idx) - first);
+}
+
+std::vector<bit_array> read_batch(std::istream &is) {
+  std::vector<std::uint8_t> buffer;
+  for (std::array<char, buffer_bytes> chunk{}; is;) {
+    is.read(chunk.data(), chunk.size());
+    buffer.insert(buffer.end(), chunk.begin(),
+                  chunk.begin() + is.gcount());
+  }
+  const auto layout = parse_batch(buffer.data(), buffer.size());
+
+  // decode the data words explicitly to stay independent of host byte order
+  const auto words = static_cast<std::size_t>(
+      (layout.index - layout.data) / static_cast<std::ptrdiff_t>(unit_bytes));
+  std::vector<storage_type> units(words);
+  for (std::size_t i = 0; i < words; i++) {
+    for (std::size_t b = 0; b < unit_bytes; b++) {
+      units[i] |= static_cast<storage_type>(layout.data[i * unit_bytes + b])
+                  << (byte_bits * b);
+    }
+  }
+
+  std::vector<bit_array> ret;
+  ret.reserve(layout.count);
+  std::uint64_t first = 0;
+  for (std::uint64_t i = 0; i < layout.count; i++) {
+    const auto end = load_le64(layout.index + i * sizeof(std::uint64_t));
+    ret.emplace_back(bit_view(units.data(), first, end - first));
+    first = end;
+  }
+  return ret;
+}
+
+} // namespace bitstring
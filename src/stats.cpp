@@ -0,0 +1,70 @@
+#include "bitstring/stats.hpp"
+
+#include <atomic>
+
+namespace bitstring::stats {
+
+namespace {
+struct atomic_counters {
+  std::atomic<std::uint64_t> calls{0};
+  std::atomic<std::uint64_t> bits{0};
+  std::atomic<std::uint64_t> allocations{0};
+  std::atomic<std::uint64_t> allocated_bytes{0};
+  std::atomic<std::uint64_t> slow_paths{0};
+};
+
+std::array<atomic_counters, op_count> counters_;
+std::atomic<trace_hook> hook_{nullptr};
+
+constexpr std::array<const char *, op_count> names{
+    "parse",   "compare",       "append_bit", "append", "prepend",
+    "reserve", "reserve_front", "rotate",     "reverse", "repeat"};
+} // namespace
+
+const char *name(op o) noexcept { return names[static_cast<std::size_t>(o)]; }
+
+snapshot take_snapshot() noexcept {
+  snapshot ret;
+  for (std::size_t i = 0; i < op_count; i++) {
+    const auto &c = counters_[i];
+    ret.ops[i] = {c.calls.load(std::memory_order_relaxed),
+                  c.bits.load(std::memory_order_relaxed),
+                  c.allocations.load(std::memory_order_relaxed),
+                  c.allocated_bytes.load(std::memory_order_relaxed),
+                  c.slow_paths.load(std::memory_order_relaxed)};
+  }
+  return ret;
+}
+
+void reset() noexcept {
+  for (auto &c : counters_) {
+    c.calls.store(0, std::memory_order_relaxed);
+    c.bits.store(0, std::memory_order_relaxed);
+    c.allocations.store(0, std::memory_order_relaxed);
+    c.allocated_bytes.store(0, std::memory_order_relaxed);
+    c.slow_paths.store(0, std::memory_order_relaxed);
+  }
+}
+
+void set_trace_hook(trace_hook hook) noexcept {
+  hook_.store(hook, std::memory_order_release);
+}
+
+void detail::record(op o, std::uint64_t bits, std::uint64_t allocated_bytes,
+                    bool slow_path) noexcept {
+  auto &c = counters_[static_cast<std::size_t>(o)];
+  c.calls.fetch_add(1, std::memory_order_relaxed);
+  c.bits.fetch_add(bits, std::memory_order_relaxed);
+  if (allocated_bytes != 0) {
+    c.allocations.fetch_add(1, std::memory_order_relaxed);
+    c.allocated_bytes.fetch_add(allocated_bytes, std::memory_order_relaxed);
+  }
+  if (slow_path) {
+    c.slow_paths.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (const auto hook = hook_.load(std::memory_order_acquire)) {
+    hook(event{o, bits, allocated_bytes, slow_path});
+  }
+}
+
+} // namespace bitstring::stats
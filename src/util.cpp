@@ -0,0 +1,56 @@
+#include "util.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace bitstring::detail {
+
+void parallel_for(std::size_t chunks, unsigned int threads,
+                  const std::function<void(std::size_t)> &fn) {
+  if (threads == 0) {
+    threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  threads = static_cast<unsigned int>(
+      std::min<std::size_t>(threads, chunks == 0 ? 1 : chunks));
+
+  std::atomic<std::size_t> next{0};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto worker = [&]() {
+    for (auto chunk = next++; chunk < chunks; chunk = next++) {
+      try {
+        fn(chunk);
+      } catch (...) {
+        const std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        next = chunks;
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  try {
+    pool.reserve(threads - 1);
+    for (unsigned int i = 1; i < threads; i++) {
+      pool.emplace_back(worker);
+    }
+  } catch (const std::system_error &) {
+    // fewer threads than requested, the running ones take over the chunks
+  }
+  worker();
+  for (auto &t : pool) {
+    t.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace bitstring::detail
@@ -1,8 +1,18 @@
 #ifndef header_bitstring_util_hpp
 #define header_bitstring_util_hpp
 
-namespace bitstring {
-  
-}
+#include <cstddef>
+#include <functional>
 
-#endif
\ No newline at end of file
+namespace bitstring::detail {
+
+// calls fn(chunk) for every chunk in [0, chunks) on up to threads threads
+// (0: one per hardware thread), chunks are handed out one at a time so
+// that faster threads pick up more of them; the first exception thrown by
+// fn is rethrown after all threads finished
+void parallel_for(std::size_t chunks, unsigned int threads,
+                  const std::function<void(std::size_t)> &fn);
+
+} // namespace bitstring::detail
+
+#endif
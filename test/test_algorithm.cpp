@@ -0,0 +1,242 @@
+#include "bitstring/algorithm.hpp"
+#include "bitstring/bit_array.hpp"
+#include "bitstring/lfsr.hpp"
+#include "util.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+// force tiny chunks such that parallel code paths are used on small inputs
+constexpr bitstring::execution::parallel_policy small_chunks{4, 100, 0};
+} // namespace
+
+SCENARIO("counting bits") {
+  GIVEN("a misaligned bit array") {
+    auto dut = bitstring::prbs15().generate(5000);
+    dut.prepend("0b111");
+    size_t expected = 0;
+    for (size_t i = 0; i < dut.size(); i++) {
+      expected += dut[i];
+    }
+    THEN("count must match the number of set bits") {
+      REQUIRE(bitstring::count(dut) == expected);
+      REQUIRE(bitstring::count(bitstring::execution::seq, dut) == expected);
+      REQUIRE(bitstring::count(small_chunks, dut) == expected);
+    }
+  }
+}
+
+SCENARIO("searching bit arrays") {
+  GIVEN("a haystack") {
+    auto haystack = bitstring::prbs15().generate(4000);
+    haystack.prepend("0b01");
+    WHEN("searching for a part of it") {
+      THEN("the first occurrence must be found") {
+        for (size_t pos : {0U, 31U, 99U, 100U, 1234U, 3950U}) {
+          auto needle = bitstring::bit_array(haystack.view().subview(pos, 50));
+          const auto found = bitstring::find(haystack, needle);
+          REQUIRE(found <= pos);
+          REQUIRE(haystack.view().subview(found, 50) == needle);
+          REQUIRE(bitstring::find(small_chunks, haystack, needle) == found);
+          REQUIRE(bitstring::find(haystack, needle, found + 1) != found);
+        }
+      }
+    }
+    WHEN("searching for something that straddles parallel chunks") {
+      auto needle = bitstring::bit_array(haystack.view().subview(95, 17));
+      THEN("it must be found") {
+        REQUIRE(bitstring::find(small_chunks, haystack, needle, 90) ==
+                bitstring::find(haystack, needle, 90));
+      }
+    }
+    WHEN("searching for something not contained") {
+      auto needle = 70 * bitstring::bit_array("0b1");
+      THEN("npos must be returned") {
+        REQUIRE(bitstring::find(haystack, needle) == bitstring::npos);
+        REQUIRE(bitstring::find(small_chunks, haystack, needle) ==
+                bitstring::npos);
+      }
+    }
+    WHEN("searching for a short needle") {
+      auto needle = bitstring::bit_array("0b1011");
+      THEN("every position must be found in order") {
+        size_t expected = 0;
+        for (; expected + 4 <= haystack.size(); expected++) {
+          if (haystack.view().subview(expected, 4) == needle) {
+            break;
+          }
+        }
+        REQUIRE(bitstring::find(haystack, needle) == expected);
+      }
+    }
+    WHEN("searching for an empty needle") {
+      THEN("start must be returned") {
+        REQUIRE(bitstring::find(haystack, bitstring::bit_array(), 7) == 7);
+      }
+    }
+  }
+}
+
+SCENARIO("parallel bulk operations") {
+  GIVEN("two equal bit arrays with different offsets") {
+    auto a = bitstring::prbs31().generate(3000);
+    auto b = a;
+    b.prepend("0b10110");
+    auto b_view = b.view().subview(5, a.size());
+    THEN("they must compare equal") {
+      REQUIRE(bitstring::equal(small_chunks, a, b_view));
+      REQUIRE(bitstring::starts_with(small_chunks, b_view,
+                                     a.view().subview(0, 2000)));
+    }
+    THEN("binary formatting must match") {
+      REQUIRE(bitstring::bin(small_chunks, b_view) == a.bin());
+    }
+    WHEN("changing a bit") {
+      a.append(true);
+      b.append(false);
+      THEN("they must differ") {
+        REQUIRE_FALSE(bitstring::equal(small_chunks, a,
+                                       b.view().subview(5, a.size())));
+        REQUIRE_FALSE(bitstring::equal(small_chunks, a, b));
+      }
+    }
+  }
+}
+
+SCENARIO("fuzzy matching of bit arrays") {
+  GIVEN("two bit arrays of the same size") {
+    auto a = bitstring::prbs15().generate(300);
+    auto b = a;
+    b.prepend("0b1");
+    auto b_view = b.view().subview(1, a.size());
+    THEN("the hamming distance must count differing bits") {
+      REQUIRE(bitstring::hamming_distance(a, b_view) == 0);
+      auto c = a;
+      c.append("0b1");
+      auto flipped = bitstring::bit_array();
+      for (size_t i = 0; i < a.size(); i++) {
+        flipped.append((a[i] != 0) != (i % 7 == 0));
+      }
+      REQUIRE(bitstring::hamming_distance(a, flipped) == 43);
+      REQUIRE_THROWS_AS(bitstring::hamming_distance(a, c), std::length_error);
+    }
+  }
+  GIVEN("a noisy capture with sync words") {
+    const auto sync = bitstring::bit_array("0x7e5a'c33c'96");
+    auto capture = bitstring::prbs7().generate(517);
+    for (size_t pos : {3U, 130U, 400U}) {
+      auto damaged = bitstring::bit_array();
+      for (size_t i = 0; i < sync.size(); i++) {
+        damaged.append((sync[i] != 0) != (i == pos % 37 || i == 11));
+      }
+      capture.append(damaged);
+      capture.append(bitstring::prbs15().generate(pos));
+    }
+    capture.prepend("0b101");
+    const auto view = capture.view().subview(3, capture.size() - 3);
+    THEN("correlation must match the brute force distances") {
+      for (size_t max_errors : {0U, 2U, 5U}) {
+        std::vector<size_t> expected;
+        for (size_t s = 0; s + sync.size() <= view.size(); s++) {
+          if (bitstring::hamming_distance(view.subview(s, sync.size()),
+                                          sync) <= max_errors) {
+            expected.push_back(s);
+          }
+        }
+        REQUIRE(bitstring::correlate(view, sync, max_errors) == expected);
+      }
+      REQUIRE(bitstring::correlate(view, sync, 2).size() >= 3);
+    }
+  }
+}
+
+SCENARIO("extracting and depositing bits by mask") {
+  GIVEN("a short bit array and a mask") {
+    const auto bits = bitstring::bit_array("0b1101'0011");
+    const auto mask = bitstring::bit_array("0b0110'1001");
+    THEN("extract must gather the selected bits in order") {
+      REQUIRE(bitstring::extract(bits, mask) ==
+              bitstring::bit_array("0b1001"));
+    }
+    THEN("deposit must scatter them back") {
+      REQUIRE(bitstring::deposit(mask, bitstring::bit_array("0b1001")) ==
+              bitstring::bit_array("0b0100'0001"));
+    }
+  }
+  GIVEN("long misaligned bit arrays") {
+    auto bits = bitstring::prbs15().generate(1000);
+    auto mask = bitstring::prbs7().generate(1000);
+    bits.prepend("0b10");
+    mask.prepend("0b1");
+    const auto b = bits.view().subview(2, 1000);
+    const auto m = mask.view().subview(1, 1000);
+    THEN("results must match the per bit reference") {
+      auto expected = bitstring::bit_array();
+      auto masked = bitstring::bit_array();
+      for (size_t i = 0; i < 1000; i++) {
+        if (m[i] != 0) {
+          expected.append(b[i] != 0);
+        }
+        masked.append((m[i] & b[i]) != 0);
+      }
+      const auto extracted = bitstring::extract(b, m);
+      REQUIRE(extracted == expected);
+      REQUIRE(bitstring::deposit(m, extracted) == masked);
+    }
+    THEN("size mismatches must throw") {
+      REQUIRE_THROWS_AS(bitstring::extract(b, m.subview(0, 999)),
+                        std::length_error);
+      REQUIRE_THROWS_AS(bitstring::deposit(m, b), std::length_error);
+    }
+  }
+}
+
+SCENARIO("locating differences between bit arrays") {
+  GIVEN("two long arrays with a few flipped bits") {
+    const auto a = bitstring::prbs15().generate(3000);
+    auto b = bitstring::bit_array();
+    for (size_t i = 0; i < a.size(); i++) {
+      const auto flipped =
+          (i >= 70 && i < 73) || i == 127 || i == 128 || i == 2999;
+      b.append((a[i] != 0) != flipped);
+    }
+    THEN("the first mismatch must be found") {
+      REQUIRE(bitstring::first_mismatch(a, b) == 70);
+      REQUIRE(bitstring::first_mismatch(a, a) == bitstring::npos);
+    }
+    THEN("diff must report maximal ranges") {
+      const auto ranges = bitstring::diff(a, b);
+      REQUIRE(ranges == std::vector<bitstring::bit_range>{
+                            {70, 3}, {127, 2}, {2999, 1}});
+      REQUIRE(bitstring::diff(a, b, 1).size() == 1);
+      REQUIRE(bitstring::diff(a, a).empty());
+    }
+    THEN("misaligned views must give the same result") {
+      auto c = bitstring::bit_array("0b101");
+      c.append(b);
+      const auto ranges = bitstring::diff(a, c.view().subview(3, 3000));
+      REQUIRE(ranges.size() == 3);
+      REQUIRE(ranges[1] == bitstring::bit_range{127, 2});
+    }
+    THEN("the summary must list the ranges") {
+      REQUIRE(bitstring::diff_summary(a, a).empty());
+      const auto summary = bitstring::diff_summary(a, b, 2);
+      REQUIRE(summary.find("6 differing bits in 3 ranges") !=
+              std::string::npos);
+      REQUIRE(summary.find("[70, 73)") != std::string::npos);
+      REQUIRE(summary.find("1 more ranges") != std::string::npos);
+    }
+  }
+  GIVEN("arrays of different sizes") {
+    const auto a = bitstring::bit_array("0b1100'1010");
+    const auto b = bitstring::bit_array("0b1100'10");
+    const auto c = bitstring::bit_array("0b1100'11");
+    THEN("the missing bits must count as a difference") {
+      REQUIRE(bitstring::first_mismatch(a, b) == 6);
+      REQUIRE(bitstring::diff(a, b) ==
+              std::vector<bitstring::bit_range>{{6, 2}});
+      REQUIRE(bitstring::diff(a, c) ==
+              std::vector<bitstring::bit_range>{{5, 3}});
+    }
+  }
+}
@@ -0,0 +1,61 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_array_pool.hpp"
+#include "bitstring/lfsr.hpp"
+#include "util.hpp"
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+SCENARIO("pooling many short bit sequences") {
+  GIVEN("a pool filled with sequences of various lengths") {
+    auto gen = bitstring::prbs15();
+    std::vector<bitstring::bit_array> expected;
+    auto dut = bitstring::bit_array_pool();
+    for (size_t i = 0; i < 500; i++) {
+      expected.push_back(gen.generate(i % 211));
+      REQUIRE(dut.push_back(expected.back()) == i);
+    }
+    THEN("every sequence must be retrievable") {
+      REQUIRE(dut.size() == expected.size());
+      for (size_t i = 0; i < expected.size(); i++) {
+        REQUIRE(dut[i] == expected[i]);
+      }
+    }
+    THEN("iteration must visit all sequences in order") {
+      size_t i = 0;
+      size_t bits = 0;
+      for (auto v : dut) {
+        REQUIRE(v == expected[i++]);
+        bits += v.size();
+      }
+      REQUIRE(i == expected.size());
+      REQUIRE(dut.bit_count() == bits);
+    }
+    WHEN("a copy is compared") {
+      auto copy = bitstring::bit_array_pool();
+      for (auto v : dut) {
+        copy.push_back(v);
+      }
+      THEN("it must be equal") { REQUIRE(copy == dut); }
+      AND_WHEN("one more sequence is added") {
+        copy.push_back(bitstring::bit_array("0b1"));
+        THEN("it must differ") { REQUIRE(copy != dut); }
+      }
+    }
+    WHEN("a sequence of the pool itself is added") {
+      dut.push_back(dut[499]);
+      THEN("it must be copied correctly") {
+        REQUIRE(dut[500] == expected[499]);
+      }
+    }
+    WHEN("the pool is cleared") {
+      dut.clear();
+      THEN("it must be empty") {
+        REQUIRE(dut.empty());
+        REQUIRE(dut.bit_count() == 0);
+        REQUIRE(dut == bitstring::bit_array_pool());
+      }
+    }
+  }
+}
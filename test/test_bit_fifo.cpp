@@ -0,0 +1,83 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_fifo.hpp"
+#include "bitstring/lfsr.hpp"
+#include "util.hpp"
+
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+SCENARIO("passing bits through a bit_fifo") {
+  GIVEN("an empty fifo") {
+    auto dut = bitstring::bit_fifo(100);
+    THEN("the capacity must be rounded up to a power of two units") {
+      REQUIRE(dut.capacity() == 128);
+      REQUIRE(dut.size() == 0);
+      REQUIRE(dut.read(10).empty());
+    }
+    WHEN("bits are written") {
+      REQUIRE(dut.write(bitstring::bit_array("0b1101")));
+      REQUIRE(dut.write_bits(0x1'0000'0003U, 40));
+      THEN("they must be read back in order") {
+        REQUIRE(dut.size() == 44);
+        REQUIRE(dut.read(3) == bitstring::bit_array("0b110"));
+        auto expected = bitstring::bit_array("0b1");
+        expected.append(bitstring::bit_array(uint64_t{0x1'0000'0003}, 40));
+        REQUIRE(dut.read(100) == expected);
+        REQUIRE(dut.size() == 0);
+      }
+    }
+    WHEN("the fifo is filled") {
+      REQUIRE(dut.write(bitstring::prbs7().generate(120)));
+      THEN("writes that don't fit must be rejected") {
+        REQUIRE_FALSE(dut.write(bitstring::bit_array(0U, 9)));
+        REQUIRE(dut.write(bitstring::bit_array(0U, 8)));
+        REQUIRE_FALSE(dut.write_bits(1, 1));
+        REQUIRE(dut.size() == 128);
+      }
+      THEN("room must become available a whole unit at a time") {
+        REQUIRE(dut.write(bitstring::bit_array(0U, 8)));
+        REQUIRE(dut.read(8).size() == 8);
+        REQUIRE_FALSE(dut.write(bitstring::bit_array(0U, 8)));
+        REQUIRE(dut.read(24).size() == 24);
+        REQUIRE(dut.write(bitstring::bit_array(0U, 32)));
+      }
+    }
+    WHEN("data is passed through many times with odd sizes") {
+      const auto source = bitstring::prbs15().generate(5000);
+      auto received = bitstring::bit_array();
+      size_t pos = 0;
+      while (pos < source.size()) {
+        const auto n = std::min<size_t>(37, source.size() - pos);
+        REQUIRE(dut.write(source.view().subview(pos, n)));
+        pos += n;
+        received.append(dut.read(pos % 5 == 0 ? 100 : 29));
+      }
+      received.append(dut.read(1000));
+      THEN("the bits must wrap around the ring unchanged") {
+        REQUIRE(received == source);
+      }
+    }
+  }
+  GIVEN("a producer and a consumer thread") {
+    const auto source = bitstring::prbs15().generate(200000);
+    auto dut = bitstring::bit_fifo(1000);
+    auto received = bitstring::bit_array();
+    std::thread producer([&source, &dut]() {
+      size_t pos = 0;
+      while (pos < source.size()) {
+        const auto n = std::min<size_t>(1 + pos % 61, source.size() - pos);
+        if (dut.write(source.view().subview(pos, n))) {
+          pos += n;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+    while (received.size() < source.size()) {
+      received.append(dut.read(1 + received.size() % 97));
+    }
+    producer.join();
+    THEN("all bits must arrive in order") { REQUIRE(received == source); }
+  }
+}
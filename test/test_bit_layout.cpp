@@ -0,0 +1,110 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_layout.hpp"
+#include "util.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+using bitstring::bitorder;
+using bitstring::field;
+
+struct id;
+struct rtr;
+struct ide;
+struct r0;
+struct dlc;
+struct payload;
+using can_header =
+    bitstring::bit_layout<field<id, 11, bitorder::msb_first>, field<rtr, 1>,
+                          field<ide, 1>, field<r0, 1>,
+                          field<dlc, 4, bitorder::msb_first>>;
+using wide_layout =
+    bitstring::bit_layout<field<id, 7>, field<payload, 64, bitorder::msb_first>,
+                          field<dlc, 60>>;
+
+static_assert(can_header::size == 18);
+static_assert(can_header::offset_of<dlc>() == 14);
+static_assert(can_header::pack_fixed({0x123, 0, 0, 0, 8}) ==
+              bitstring::fixed_bit_array<18>(0b00100100011'0'0'0'1000U,
+                                             bitorder::msb_first));
+static_assert(
+    can_header::unpack(can_header::pack_fixed({0x7f0, 1, 0, 1, 3}))[4] == 3);
+
+#if defined(__cpp_nontype_template_args) &&                                    \
+    __cpp_nontype_template_args >= 201911L
+using named_header =
+    bitstring::bit_layout<bitstring::named_field<"id", 11, bitorder::msb_first>,
+                          bitstring::named_field<"rtr", 1>>;
+static_assert(named_header::offset_of<bitstring::name<"rtr">>() == 11);
+#endif
+} // namespace
+
+SCENARIO("packing bit layouts") {
+  GIVEN("a CAN like header layout") {
+    can_header::values_type values{0x4a3, 1, 0, 1, 0xb};
+    WHEN("packing") {
+      auto dut = can_header::pack(values);
+      THEN("result must match appending single fields") {
+        auto expected = bitstring::bit_array(0x4a3U, 11, bitorder::msb_first)
+                            .append(bitstring::bit_array(1U, 1))
+                            .append(bitstring::bit_array(0U, 1))
+                            .append(bitstring::bit_array(1U, 1))
+                            .append(bitstring::bit_array(0xbU, 4,
+                                                         bitorder::msb_first));
+        REQUIRE(dut == expected);
+      }
+      THEN("unpacking must return the original values") {
+        REQUIRE(can_header::unpack(dut) == values);
+      }
+      THEN("single fields must be accessible by name") {
+        REQUIRE(can_header::get<id>(dut) == 0x4a3);
+        REQUIRE(can_header::get<dlc>(dut) == 0xb);
+        REQUIRE(can_header::get<r0>(values) == 1);
+      }
+    }
+    WHEN("appending to a misaligned bit array") {
+      auto dut = bitstring::bit_array("0b101");
+      dut.prepend("0b0");
+      can_header::append_to(dut, values);
+      THEN("fields must follow the existing bits") {
+        REQUIRE(dut ==
+                bitstring::bit_array("0b0101") + can_header::pack(values));
+        REQUIRE(can_header::unpack(dut.view().subview(4, 18)) == values);
+      }
+    }
+    WHEN("unpacking a too short view") {
+      auto dut = bitstring::bit_array("0b101");
+      THEN("an exception must be thrown") {
+        REQUIRE_THROWS_AS(can_header::unpack(dut), std::length_error);
+      }
+    }
+  }
+  GIVEN("a layout with fields crossing 64 bit boundaries") {
+    wide_layout::values_type values{0x55, UINT64_C(0x8123456789abcdef),
+                                    UINT64_C(0xfedcba987654321)};
+    WHEN("packing into a raw byte buffer at an odd offset") {
+      std::array<uint8_t, 20> buffer{};
+      buffer.fill(0xff);
+      wide_layout::pack_into(buffer.data(), 5, values);
+      THEN("unpacking must return the original values") {
+        REQUIRE(wide_layout::unpack_from(buffer.data(), 5) == values);
+      }
+      THEN("surrounding bits must be untouched") {
+        REQUIRE((buffer[0] & 0x1f) == 0x1f);
+        REQUIRE((buffer[16] & 0xe0) == 0xe0);
+        REQUIRE(buffer[17] == 0xff);
+      }
+    }
+    WHEN("packing into a bit_array") {
+      auto dut = wide_layout::pack(values);
+      THEN("result must match appending single fields") {
+        auto expected =
+            bitstring::bit_array(0x55U, 7)
+                .append(bitstring::bit_array(UINT64_C(0x8123456789abcdef),
+                                             bitorder::msb_first))
+                .append(bitstring::bit_array(UINT64_C(0xfedcba987654321), 60));
+        REQUIRE(dut == expected);
+      }
+    }
+  }
+}
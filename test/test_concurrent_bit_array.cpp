@@ -0,0 +1,100 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/concurrent_bit_array.hpp"
+#include "bitstring/lfsr.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+bitstring::bit_array zeros(size_t n) {
+  return bitstring::bit_array(
+      std::vector<bitstring::bit_array::storage_type>(
+          bitstring::bit_array::storage_units(n)),
+      n);
+}
+} // namespace
+
+SCENARIO("modifying a concurrent bit array") {
+  GIVEN("an empty concurrent bit array") {
+    auto dut = bitstring::concurrent_bit_array(100);
+    THEN("all bits must be unset") {
+      REQUIRE(dut.size() == 100);
+      REQUIRE(dut.count() == 0);
+      REQUIRE(dut.snapshot() == zeros(100));
+    }
+    WHEN("single bits are set and reset") {
+      REQUIRE_FALSE(dut.test_and_set(3));
+      REQUIRE(dut.test_and_set(3));
+      REQUIRE_FALSE(dut.test_and_set(99));
+      REQUIRE(dut.reset(99));
+      REQUIRE_FALSE(dut.reset(99));
+      THEN("only the remaining bit must be set") {
+        REQUIRE(dut.test(3));
+        REQUIRE_FALSE(dut.test(99));
+        REQUIRE(dut.count() == 1);
+      }
+    }
+    WHEN("a range is or-ed in at an unaligned position") {
+      const auto bits = bitstring::prbs7().generate(70);
+      dut.fetch_or(13, bits);
+      THEN("the snapshot must hold the range") {
+        auto expected = zeros(13);
+        expected.append(bits).append(zeros(17));
+        REQUIRE(dut.snapshot() == expected);
+        REQUIRE(dut.count() == bitstring::count(bits));
+      }
+    }
+    THEN("ranges exceeding the array must throw") {
+      REQUIRE_THROWS_AS(dut.fetch_or(90, zeros(11)),
+                        std::out_of_range);
+    }
+    WHEN("all bits are claimed") {
+      std::vector<size_t> claimed;
+      for (auto idx = dut.claim(50); idx != bitstring::npos;
+           idx = dut.claim(50)) {
+        claimed.push_back(idx);
+      }
+      THEN("every bit must have been claimed once") {
+        std::sort(claimed.begin(), claimed.end());
+        REQUIRE(claimed.size() == 100);
+        REQUIRE(claimed.front() == 0);
+        REQUIRE(claimed.back() == 99);
+        REQUIRE(std::adjacent_find(claimed.begin(), claimed.end()) ==
+                claimed.end());
+        REQUIRE(dut.count() == 100);
+      }
+    }
+  }
+  GIVEN("many threads claiming bits at once") {
+    constexpr size_t threads = 8;
+    auto dut = bitstring::concurrent_bit_array(10000);
+    std::vector<std::vector<size_t>> claimed(threads);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; t++) {
+      workers.emplace_back([&dut, &claimed, t]() {
+        const auto hint = dut.spread_hint(t, threads);
+        for (auto idx = dut.claim(hint); idx != bitstring::npos;
+             idx = dut.claim(hint)) {
+          claimed[t].push_back(idx);
+        }
+      });
+    }
+    for (auto &w : workers) {
+      w.join();
+    }
+    THEN("every bit must have been claimed by exactly one thread") {
+      std::vector<size_t> all;
+      for (const auto &c : claimed) {
+        all.insert(all.end(), c.begin(), c.end());
+      }
+      std::sort(all.begin(), all.end());
+      REQUIRE(all.size() == 10000);
+      REQUIRE(std::adjacent_find(all.begin(), all.end()) == all.end());
+      REQUIRE(dut.count() == 10000);
+    }
+  }
+}
@@ -0,0 +1,127 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/crc.hpp"
+#include "bitstring/lfsr.hpp"
+#include "util.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+const std::vector<uint8_t> check_bytes{'1', '2', '3', '4', '5',
+                                       '6', '7', '8', '9'};
+
+bitstring::bit_array msb_first_bytes(const std::vector<uint8_t> &bytes) {
+  bitstring::bit_array ret;
+  for (auto b : bytes) {
+    ret.append(bitstring::bit_array(b, bitstring::bitorder::msb_first));
+  }
+  return ret;
+}
+
+// straightforward shift register implementation of the same model
+uint64_t crc_reference(const bitstring::crc_params &p,
+                       const bitstring::bit_array &bits) {
+  const auto top = uint64_t{1} << (p.width - 1);
+  const auto mask = top | (top - 1);
+  auto reg = p.init;
+  for (size_t i = 0; i < bits.size(); i++) {
+    const bool feedback = ((reg & top) != 0) != (bits[i] != 0);
+    reg = ((reg << 1U) & mask) ^ (feedback ? p.poly : 0);
+  }
+  if (p.refout) {
+    reg = bitstring::detail::bitflipped(reg) >> (64 - p.width);
+  }
+  return reg ^ p.xorout;
+}
+} // namespace
+
+SCENARIO("computing CRCs") {
+  using namespace bitstring::crc_catalog;
+  GIVEN("the catalogue check string") {
+    THEN("LSB first arrays must match refin=true check values") {
+      auto lsb_first = bitstring::bit_array(check_bytes);
+      REQUIRE(bitstring::crc(crc32, lsb_first) == 0xcbf43926);
+      REQUIRE(bitstring::crc(crc16_kermit, lsb_first) == 0x2189);
+    }
+    THEN("MSB first arrays must match refin=false check values") {
+      auto msb_first = msb_first_bytes(check_bytes);
+      REQUIRE(bitstring::crc(crc16_ccitt_false, msb_first) == 0x29b1);
+      REQUIRE(bitstring::crc(crc15_can, msb_first) == 0x059e);
+    }
+  }
+  GIVEN("bit arrays of arbitrary length and offset") {
+    auto data = bitstring::bit_array(
+        std::vector<uint8_t>{0x3c, 0xa5, 0x17, 0xf0, 0x81, 0x7e, 0x99, 0x42,
+                             0x5a, 0xc3, 0x0f, 0x66, 0xd1, 0x28});
+    data.prepend("0b101");
+    THEN("every prefix of every suffix must match the reference") {
+      for (auto p : {crc15_can, crc16_ccitt_false, crc32}) {
+        for (size_t start = 0; start < 11; start++) {
+          for (size_t len = 0; len + start < data.size(); len += 7) {
+            auto view = data.view().subview(start, len);
+            REQUIRE(bitstring::crc(p, view) ==
+                    crc_reference(p, bitstring::bit_array(view)));
+          }
+        }
+      }
+    }
+    THEN("incremental updates must match a single update") {
+      auto engine = bitstring::crc_engine(crc32);
+      engine.update(data.view().subview(0, 13));
+      engine.update(data.view().subview(13, 40));
+      engine.update(data.view().subview(53, data.size() - 53));
+      REQUIRE(engine.value() == bitstring::crc(crc32, data));
+    }
+  }
+}
+
+SCENARIO("generating PRBS sequences") {
+  GIVEN("a PRBS7 generator") {
+    auto gen = bitstring::prbs7();
+    WHEN("generating two periods") {
+      auto dut = gen.generate(2 * 127);
+      THEN("sequence must repeat after 127 bits") {
+        REQUIRE(dut.view().subview(0, 127) == dut.view().subview(127, 127));
+      }
+      THEN("a maximum length sequence has 64 ones per period") {
+        size_t ones = 0;
+        for (size_t i = 0; i < 127; i++) {
+          ones += dut[i];
+        }
+        REQUIRE(ones == 64);
+      }
+    }
+  }
+  GIVEN("a PRBS31 generator") {
+    auto gen = bitstring::prbs31(0x12345678);
+    WHEN("generating bits") {
+      auto dut = gen.generate(1000);
+      THEN("bits must match a per-bit shift register") {
+        uint64_t state = 0x12345678;
+        bitstring::bit_array expected;
+        for (size_t i = 0; i < 1000; i++) {
+          const auto bit = ((state >> 0) ^ (state >> 3)) & 1U;
+          state = (state >> 1) | (bit << 30);
+          expected.append(bit != 0);
+        }
+        REQUIRE(dut == expected);
+      }
+    }
+  }
+  GIVEN("some data") {
+    auto data = 37 * bitstring::bit_array("0b110100111");
+    WHEN("scrambling and descrambling") {
+      auto scrambled = bitstring::prbs15().scramble(data);
+      auto descrambled = bitstring::prbs15().scramble(scrambled);
+      THEN("data must be changed by scrambling") { REQUIRE(scrambled != data); }
+      THEN("descrambling must restore the data") {
+        REQUIRE(descrambled == data);
+      }
+      THEN("scrambling must be XOR with the sequence") {
+        auto seq = bitstring::prbs15().generate(data.size());
+        for (size_t i = 0; i < data.size(); i++) {
+          REQUIRE(scrambled[i] == (data[i] ^ seq[i]));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,91 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/fixed_bit_array.hpp"
+#include "bitstring/literals.hpp"
+#include "util.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace bitstring::literals;
+
+// all of these must be usable in constant expressions
+constexpr auto header = 0b1101'0001'01_fba;
+static_assert(header.size() == 10);
+static_assert(header[0] == 1 && header[2] == 0 && header[9] == 1);
+static_assert(header.data()[0] == 0b1010001011);
+constexpr auto mask = ~bitstring::fixed_bit_array<10>(0x3U);
+static_assert(mask.data()[0] == 0b1111111100);
+static_assert((header & mask) == 0b0001'0001'01_fba);
+static_assert((header + 0b111_fba).size() == 13);
+static_assert((header + 0b111_fba)[12] == 1);
+static_assert(0x3A_fba == 0b0011'1010_fba);
+static_assert((0x1'f_fba).size() == 8);
+
+SCENARIO("fixed size bit arrays") {
+  GIVEN("a fixed bit array literal") {
+    constexpr auto dut = 0b10110001_fba;
+    THEN("it must match the runtime literal") {
+      REQUIRE(dut.bin() == "10110001");
+      REQUIRE(dut.to_bit_array() == "0b10110001"_ba);
+    }
+    THEN("it must compare equal to a matching bit_array") {
+      REQUIRE(dut == bitstring::bit_array("0b10110001"));
+      REQUIRE(dut != bitstring::bit_array("0b10110000"));
+      REQUIRE(dut != bitstring::bit_array("0b101100010"));
+    }
+    WHEN("appending it to a misaligned bit_array") {
+      auto ba = bitstring::bit_array("0b101");
+      ba.prepend("0b11");
+      ba.append(dut);
+      THEN("bits must be appended") {
+        REQUIRE(ba == bitstring::bit_array("0b11101'10110001"));
+      }
+    }
+  }
+  GIVEN("a multi unit integer") {
+    constexpr auto dut = bitstring::fixed_bit_array<40>(
+        UINT64_C(0xff11223344), bitstring::bitorder::msb_first);
+    THEN("it must match the bit_array constructor") {
+      REQUIRE(dut == bitstring::bit_array(UINT64_C(0xff11223344) << 24,
+                                          bitstring::bitorder::msb_first)
+                         .front(40));
+    }
+    THEN("padding must be clear") { REQUIRE(dut.data()[1] == 0x22); }
+  }
+  GIVEN("a bit_array") {
+    auto ba = bitstring::bit_array("0b0111'0110'1");
+    ba.prepend("0b1");
+    WHEN("converting to a fixed bit array") {
+      auto dut = bitstring::fixed_bit_array<10>(ba);
+      THEN("bits must be equal") { REQUIRE(dut == ba); }
+    }
+    WHEN("converting to a fixed bit array of wrong size") {
+      THEN("an exception must be thrown") {
+        REQUIRE_THROWS_AS(bitstring::fixed_bit_array<9>(ba), std::length_error);
+      }
+    }
+  }
+}
+
+SCENARIO("viewing bit arrays") {
+  GIVEN("a misaligned bit array") {
+    auto ba = bitstring::bit_array("0b1100101011110000111");
+    ba.prepend("0b010");
+    auto view = ba.view();
+    THEN("view must show the same bits") {
+      REQUIRE(view.size() == ba.size());
+      REQUIRE(view.bin() == ba.bin());
+    }
+    THEN("subviews must show a part of the bits") {
+      REQUIRE(view.subview(2, 5).bin() == "01100");
+      REQUIRE(bitstring::bit_array(view.subview(2, 5)) ==
+              bitstring::bit_array("0b01100"));
+    }
+    THEN("appending a subview of itself must work") {
+      ba.append(view.subview(0, 3));
+      REQUIRE(ba == bitstring::bit_array("0b010'1100101011110000111'010"));
+    }
+    THEN("out of range subviews must throw") {
+      REQUIRE_THROWS_AS(view.subview(20, 3), std::out_of_range);
+    }
+  }
+}
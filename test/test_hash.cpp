@@ -0,0 +1,63 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/hash.hpp"
+#include "bitstring/lfsr.hpp"
+#include "util.hpp"
+
+#include <unordered_set>
+
+#include <catch2/catch_test_macros.hpp>
+
+SCENARIO("hashing bit arrays") {
+  GIVEN("equal bit arrays with different storage offsets") {
+    auto a = bitstring::prbs15().generate(1000);
+    auto b = a;
+    b.prepend("0b1011");
+    auto b_view = b.view().subview(4, a.size());
+    THEN("their hashes must be equal") {
+      REQUIRE(bitstring::hash(a) == bitstring::hash(b_view));
+      REQUIRE(std::hash<bitstring::bit_array>{}(a) ==
+              std::hash<bitstring::bit_view>{}(b_view));
+      const auto copy = bitstring::bit_array(b_view);
+      REQUIRE(std::hash<bitstring::bit_array>{}(a) ==
+              std::hash<bitstring::bit_array>{}(copy));
+    }
+    THEN("the hash must not depend on how the input is split") {
+      for (size_t split : {0U, 1U, 31U, 64U, 65U, 500U, 1000U}) {
+        auto hasher = bitstring::bit_hasher();
+        hasher.update(a.view().subview(0, split));
+        hasher.update(a.view().subview(split, a.size() - split));
+        REQUIRE(hasher.digest() == bitstring::hash(a));
+      }
+      auto hasher = bitstring::bit_hasher();
+      for (size_t pos = 0; pos < a.size(); pos += 7) {
+        const auto n = std::min<size_t>(7, a.size() - pos);
+        hasher.update(a.view().subview(pos, n));
+      }
+      REQUIRE(hasher.digest() == bitstring::hash(a));
+    }
+    THEN("the seed must change the hash") {
+      REQUIRE(bitstring::hash(a, 1) != bitstring::hash(a));
+    }
+  }
+  GIVEN("bit arrays differing only in length") {
+    const auto a = bitstring::bit_array("0b0");
+    const auto b = bitstring::bit_array("0b00");
+    THEN("their hashes must differ") {
+      REQUIRE(bitstring::hash(a) != bitstring::hash(b));
+      REQUIRE(bitstring::hash(bitstring::bit_array()) != bitstring::hash(a));
+    }
+  }
+  GIVEN("all short bit arrays") {
+    std::unordered_set<bitstring::bit_array> seen;
+    for (size_t len = 0; len <= 10; len++) {
+      for (unsigned int v = 0; v < (1U << len); v++) {
+        seen.insert(bitstring::bit_array(v, len));
+      }
+    }
+    THEN("they must be usable as keys") {
+      REQUIRE(seen.size() == 2047);
+      REQUIRE(seen.count(bitstring::bit_array("0b1011")) == 1);
+      REQUIRE(seen.count(bitstring::bit_array("0b10110100101")) == 0);
+    }
+  }
+}
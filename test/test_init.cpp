@@ -275,6 +275,58 @@ SCENARIO("init from string") {
     }
   }
 
+  GIVEN("hex and octal strings") {
+    THEN("digits must be expanded MSB first in order") {
+      using bitstring::bit_array;
+      REQUIRE(bit_array("0x3a") == bit_array("0b00111010"));
+      REQUIRE(bit_array("0xF_0") == bit_array("0b11110000"));
+      REQUIRE(bit_array("0o17") == bit_array("0b001111"));
+    }
+    THEN("long strings must match the binary expansion") {
+      std::string hex{"0x"};
+      std::string bin{"0b"};
+      const std::string digits{"0123456789abcdefABCDEF"};
+      const std::string expansions[] = {
+          "0000", "0001", "0010", "0011", "0100", "0101", "0110", "0111",
+          "1000", "1001", "1010", "1011", "1100", "1101", "1110", "1111",
+          "1010", "1011", "1100", "1101", "1110", "1111"};
+      for (size_t i = 0; i < 500; i++) {
+        const auto d = (i * 7) % digits.size();
+        hex += digits[d];
+        bin += expansions[d];
+        if (i % 37 == 0) {
+          hex += '\'';
+        }
+      }
+      REQUIRE(bitstring::bit_array(hex) == bitstring::bit_array(bin));
+      REQUIRE(bitstring::bit_array(bin.substr(0, 300)) ==
+              bitstring::bit_array(bin).front(298));
+    }
+    THEN("invalid digits must be rejected") {
+      REQUIRE_THROWS_AS(bitstring::bit_array("0x0123456g"),
+                        bitstring::parse_error);
+      REQUIRE_THROWS_AS(bitstring::bit_array("0o8"), bitstring::parse_error);
+    }
+  }
+
+  GIVEN("strings with an explicit length") {
+    THEN("values must be right aligned") {
+      REQUIRE(bitstring::bit_array("12'0x3ff") ==
+              bitstring::bit_array("0b0011'1111'1111"));
+      REQUIRE(bitstring::bit_array("10'0x3ff") ==
+              bitstring::bit_array("0b11'1111'1111"));
+      REQUIRE(bitstring::bit_array("6'0b101") ==
+              bitstring::bit_array("0b000101"));
+      REQUIRE(bitstring::bit_array("0'0x0").empty());
+    }
+    THEN("values exceeding the length must be rejected") {
+      REQUIRE_THROWS_AS(bitstring::bit_array("9'0x3ff"),
+                        bitstring::parse_error);
+      REQUIRE_THROWS_AS(bitstring::bit_array("1x'0x3"),
+                        bitstring::parse_error);
+    }
+  }
+
   GIVEN("string with invalid prefix") {
     const std::string s{"0e010100101010"};
     WHEN("constructing bit_array from it") {
@@ -0,0 +1,132 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_stream.hpp"
+#include "bitstring/exceptions.hpp"
+#include "bitstring/integer_codes.hpp"
+#include "util.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+using bitstring::integer_code;
+
+namespace {
+bitstring::bit_array encode(uint64_t v, integer_code code, size_t k = 0) {
+  return bitstring::encode_integers({v}, code, k);
+}
+
+// values of all magnitudes, including the limits of each code
+std::vector<uint64_t> test_values(uint64_t max) {
+  std::vector<uint64_t> ret{0U, 1U, 2U, 3U, 127U, 128U, 300U, max};
+  std::mt19937_64 gen(7);
+  for (size_t bits = 1; bits < 64; bits++) {
+    ret.push_back(gen() >> bits);
+  }
+  for (auto &v : ret) {
+    v = v > max ? max : v;
+  }
+  return ret;
+}
+} // namespace
+
+SCENARIO("encoding integers with universal codes") {
+  GIVEN("known code words") {
+    THEN("exp-golomb must match the ue(v) table") {
+      REQUIRE(encode(0, integer_code::exp_golomb) ==
+              bitstring::bit_array("0b1"));
+      REQUIRE(encode(1, integer_code::exp_golomb) ==
+              bitstring::bit_array("0b010"));
+      REQUIRE(encode(4, integer_code::exp_golomb) ==
+              bitstring::bit_array("0b00101"));
+      REQUIRE(encode(4, integer_code::exp_golomb, 2) ==
+              bitstring::bit_array("0b01000"));
+    }
+    THEN("elias codes must match their definition") {
+      REQUIRE(encode(1, integer_code::elias_gamma) ==
+              bitstring::bit_array("0b1"));
+      REQUIRE(encode(9, integer_code::elias_gamma) ==
+              bitstring::bit_array("0b0001001"));
+      REQUIRE(encode(1, integer_code::elias_delta) ==
+              bitstring::bit_array("0b1"));
+      REQUIRE(encode(9, integer_code::elias_delta) ==
+              bitstring::bit_array("0b00100001"));
+    }
+    THEN("rice and leb128 must match their definition") {
+      REQUIRE(encode(9, integer_code::rice, 2) ==
+              bitstring::bit_array("0b001'01"));
+      REQUIRE(encode(300, integer_code::leb128) ==
+              bitstring::bit_array(uint16_t{0x02ac}, 16));
+    }
+    THEN("values the code cannot represent must throw") {
+      REQUIRE_THROWS_AS(encode(0, integer_code::elias_gamma),
+                        std::out_of_range);
+      REQUIRE_THROWS_AS(encode(~uint64_t{0}, integer_code::exp_golomb),
+                        std::out_of_range);
+      REQUIRE_THROWS_AS(encode(1, integer_code::rice, 64), std::out_of_range);
+    }
+  }
+  GIVEN("many values of every magnitude") {
+    const auto all = test_values(~uint64_t{0});
+    const auto eg = test_values(~uint64_t{0} - 1);
+    const auto eg5 = test_values(~uint64_t{0} - 32);
+    auto nonzero = test_values(~uint64_t{0});
+    for (auto &v : nonzero) {
+      v = v == 0 ? 1 : v;
+    }
+    const auto small = test_values(1U << 20U);
+    THEN("every code must round trip") {
+      REQUIRE(bitstring::decode_integers(
+                  bitstring::encode_integers(eg, integer_code::exp_golomb),
+                  integer_code::exp_golomb) == eg);
+      REQUIRE(bitstring::decode_integers(
+                  bitstring::encode_integers(eg5, integer_code::exp_golomb, 5),
+                  integer_code::exp_golomb, 5) == eg5);
+      REQUIRE(bitstring::decode_integers(
+                  bitstring::encode_integers(nonzero,
+                                             integer_code::elias_gamma),
+                  integer_code::elias_gamma) == nonzero);
+      REQUIRE(bitstring::decode_integers(
+                  bitstring::encode_integers(nonzero,
+                                             integer_code::elias_delta),
+                  integer_code::elias_delta) == nonzero);
+      REQUIRE(bitstring::decode_integers(
+                  bitstring::encode_integers(small, integer_code::rice, 3),
+                  integer_code::rice, 3) == small);
+      REQUIRE(bitstring::decode_integers(
+                  bitstring::encode_integers(all, integer_code::leb128),
+                  integer_code::leb128) == all);
+    }
+    THEN("batch decoding must stop at the requested count") {
+      const auto bits = bitstring::encode_integers(all, integer_code::leb128);
+      auto in = bitstring::bit_reader(bits);
+      std::vector<uint64_t> out(5);
+      REQUIRE(bitstring::decode_integers(in, out.data(), 5,
+                                         integer_code::leb128) == 5);
+      REQUIRE(out == std::vector<uint64_t>(all.begin(), all.begin() + 5));
+      REQUIRE(bitstring::decode_integer(in, integer_code::leb128) == all[5]);
+    }
+  }
+  GIVEN("malformed input") {
+    THEN("truncated and oversized values must be rejected") {
+      REQUIRE_THROWS_AS(
+          bitstring::decode_integers(bitstring::bit_array("0b001"),
+                                     integer_code::exp_golomb),
+          bitstring::decode_error);
+      REQUIRE_THROWS_AS(
+          bitstring::decode_integers(bitstring::bit_array(0U, 80),
+                                     integer_code::exp_golomb),
+          bitstring::decode_error);
+      REQUIRE_THROWS_AS(
+          bitstring::decode_integers(bitstring::bit_array(uint8_t{0x80}, 8),
+                                     integer_code::leb128),
+          bitstring::decode_error);
+      const auto too_long = bitstring::bit_array(~uint64_t{0}, 64) +
+                            bitstring::bit_array(uint16_t{0x02ff}, 16);
+      REQUIRE_THROWS_AS(
+          bitstring::decode_integers(too_long, integer_code::leb128),
+          bitstring::decode_error);
+    }
+  }
+}
@@ -0,0 +1,73 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_ops.hpp"
+#include "bitstring/interleave.hpp"
+#include "bitstring/lfsr.hpp"
+#include "util.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+static_assert(bitstring::detail::transpose8(0x00000000000000ffULL) ==
+              0x0101010101010101ULL);
+static_assert(bitstring::detail::transpose8(0x8040201008040201ULL) ==
+              0x8040201008040201ULL);
+
+SCENARIO("deinterleaving multi lane captures") {
+  GIVEN("a capture of two lanes") {
+    const auto source = bitstring::bit_array("0b10'11'00'01'10");
+    THEN("every other bit must go to the same lane") {
+      const auto lanes = bitstring::deinterleave(source, 2);
+      REQUIRE(lanes.size() == 2);
+      REQUIRE(lanes[0] == bitstring::bit_array("0b11001"));
+      REQUIRE(lanes[1] == bitstring::bit_array("0b01010"));
+    }
+  }
+  GIVEN("captures with various lane counts and offsets") {
+    auto gen = bitstring::prbs15();
+    THEN("lanes must match the per bit reference and interleave back") {
+      for (size_t lanes : {1U, 3U, 8U, 12U, 16U, 32U, 37U}) {
+        for (size_t offset : {0U, 8U, 5U}) {
+          auto capture = gen.generate(offset + lanes * 203);
+          const auto source =
+              capture.view().subview(offset, capture.size() - offset);
+          const auto dut = bitstring::deinterleave(source, lanes);
+          REQUIRE(dut.size() == lanes);
+          for (size_t l = 0; l < lanes; l++) {
+            REQUIRE(dut[l].size() == 203);
+            for (size_t t = 0; t < 203; t++) {
+              REQUIRE(dut[l][t] == source[t * lanes + l]);
+            }
+          }
+          REQUIRE(bitstring::interleave(dut) == source);
+        }
+      }
+    }
+  }
+  GIVEN("invalid lane counts") {
+    const auto source = bitstring::bit_array("0b1011'0");
+    THEN("deinterleaving must throw") {
+      REQUIRE_THROWS_AS(bitstring::deinterleave(source, 0),
+                        std::invalid_argument);
+      REQUIRE_THROWS_AS(bitstring::deinterleave(source, 2),
+                        std::invalid_argument);
+    }
+  }
+}
+
+SCENARIO("interleaving lanes") {
+  GIVEN("lanes of different size") {
+    const auto lanes = std::vector<bitstring::bit_array>{
+        bitstring::bit_array("0b101"), bitstring::bit_array("0b10")};
+    THEN("interleaving must throw") {
+      REQUIRE_THROWS_AS(bitstring::interleave(lanes), std::invalid_argument);
+    }
+  }
+  GIVEN("no lanes") {
+    THEN("the result must be empty") {
+      REQUIRE(bitstring::interleave(std::vector<bitstring::bit_array>{})
+                  .empty());
+    }
+  }
+}
@@ -0,0 +1,166 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_stream.hpp"
+#include "bitstring/exceptions.hpp"
+#include "bitstring/line_coding.hpp"
+#include "util.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+bitstring::bit_array test_pattern() {
+  auto ret = bitstring::bit_array(std::vector<uint8_t>{
+      0xff, 0xff, 0x00, 0x00, 0x1f, 0x3e, 0x7c, 0xf8, 0x0f, 0xf0, 0xaa, 0x55,
+      0xfe, 0x01, 0x80, 0x7f, 0xc3, 0x3c, 0x99, 0x66, 0xe7, 0x18, 0xff, 0xf7});
+  ret.prepend("0b11");
+  return ret;
+}
+
+// per bit reference implementations
+bitstring::bit_array stuff_reference(const bitstring::bit_array &in,
+                                     bitstring::stuffing mode) {
+  bitstring::bit_array ret;
+  int run = 0;
+  bool last = false;
+  for (size_t i = 0; i < in.size(); i++) {
+    const bool bit = in[i] != 0;
+    ret.append(bit);
+    if (mode == bitstring::stuffing::hdlc) {
+      run = bit ? run + 1 : 0;
+      if (run == 5) {
+        ret.append(false);
+        run = 0;
+      }
+    } else {
+      run = (run != 0 && bit == last) ? run + 1 : 1;
+      last = bit;
+      if (run == 5) {
+        last = !bit;
+        ret.append(last);
+        run = 1;
+      }
+    }
+  }
+  return ret;
+}
+} // namespace
+
+SCENARIO("bit stuffing") {
+  using bitstring::stuffing;
+  GIVEN("a short HDLC payload") {
+    auto dut = bitstring::bit_array("0b0111111011111");
+    THEN("a 0 must be inserted after five 1s") {
+      REQUIRE(bitstring::stuff(dut) ==
+              bitstring::bit_array("0b011111'0'10'11111'0"));
+    }
+  }
+  GIVEN("a short CAN payload") {
+    auto dut = bitstring::bit_array("0b000001111100000");
+    THEN("the complement must be inserted after five equal bits") {
+      REQUIRE(bitstring::stuff(dut, stuffing::can) ==
+              bitstring::bit_array("0b000001'111101'000001"));
+    }
+  }
+  GIVEN("a long pattern") {
+    auto dut = test_pattern();
+    const auto modes = {stuffing::hdlc, stuffing::can};
+    THEN("stuffing must match the per bit reference") {
+      for (auto mode : modes) {
+        REQUIRE(bitstring::stuff(dut, mode) == stuff_reference(dut, mode));
+      }
+    }
+    THEN("unstuffing must restore the input") {
+      for (auto mode : modes) {
+        REQUIRE(bitstring::unstuff(bitstring::stuff(dut, mode), mode) == dut);
+      }
+    }
+    THEN("stuffing in chunks must match stuffing in one go") {
+      for (auto mode : modes) {
+        auto stuff = bitstring::stuffer(mode);
+        auto out = bitstring::bit_writer();
+        stuff(dut.view().subview(0, 13), out);
+        stuff(dut.view().subview(13, 100), out);
+        stuff(dut.view().subview(113, dut.size() - 113), out);
+        REQUIRE(out.finish() == bitstring::stuff(dut, mode));
+      }
+    }
+  }
+  GIVEN("a stream with a stuffing violation") {
+    THEN("unstuffing must throw") {
+      REQUIRE_THROWS_AS(
+          bitstring::unstuff(bitstring::bit_array("0b0111111")),
+          bitstring::decode_error);
+      REQUIRE_THROWS_AS(bitstring::unstuff(bitstring::bit_array(
+                                               "0b1000000000000000"),
+                                           stuffing::can),
+                        bitstring::decode_error);
+    }
+  }
+}
+
+SCENARIO("manchester coding") {
+  using bitstring::manchester;
+  GIVEN("a few bits") {
+    auto dut = bitstring::bit_array("0b0110");
+    THEN("IEEE 802.3 must send 0 as 10 and 1 as 01") {
+      REQUIRE(bitstring::manchester_encode(dut) ==
+              bitstring::bit_array("0b10'01'01'10"));
+    }
+    THEN("G.E. Thomas must send 0 as 01 and 1 as 10") {
+      REQUIRE(bitstring::manchester_encode(dut, manchester::thomas) ==
+              bitstring::bit_array("0b01'10'10'01"));
+    }
+  }
+  GIVEN("a long pattern") {
+    auto dut = test_pattern();
+    THEN("decoding must restore the input") {
+      for (auto convention : {manchester::ieee_802_3, manchester::thomas}) {
+        auto encoded = bitstring::manchester_encode(dut, convention);
+        REQUIRE(encoded.size() == 2 * dut.size());
+        REQUIRE(bitstring::manchester_decode(encoded, convention) == dut);
+      }
+    }
+  }
+  GIVEN("invalid symbols") {
+    THEN("decoding must throw") {
+      REQUIRE_THROWS_AS(
+          bitstring::manchester_decode(bitstring::bit_array("0b1001100")),
+          bitstring::decode_error);
+      REQUIRE_THROWS_AS(
+          bitstring::manchester_decode(bitstring::bit_array("0b10011001'11")),
+          bitstring::decode_error);
+    }
+  }
+}
+
+SCENARIO("NRZI coding") {
+  using bitstring::nrzi;
+  GIVEN("a few bits") {
+    auto dut = bitstring::bit_array("0b0011010");
+    THEN("USB style NRZI must toggle on 0") {
+      REQUIRE(bitstring::nrzi_encode(dut) == bitstring::bit_array("0b1000110"));
+    }
+    THEN("NRZ-M must toggle on 1") {
+      REQUIRE(bitstring::nrzi_encode(dut, nrzi::transition_on_one, true) ==
+              bitstring::bit_array("0b1101100"));
+    }
+  }
+  GIVEN("a long pattern") {
+    auto dut = test_pattern();
+    const auto modes = {nrzi::transition_on_zero, nrzi::transition_on_one};
+    THEN("decoding must restore the input") {
+      for (auto mode : modes) {
+        REQUIRE(bitstring::nrzi_decode(bitstring::nrzi_encode(dut, mode, true),
+                                       mode, true) == dut);
+      }
+    }
+    THEN("encoding in chunks must match encoding in one go") {
+      for (auto mode : modes) {
+        auto encode = bitstring::nrzi_encoder(mode);
+        auto out = bitstring::bit_writer();
+        encode(dut.view().subview(0, 45), out);
+        encode(dut.view().subview(45, dut.size() - 45), out);
+        REQUIRE(out.finish() == bitstring::nrzi_encode(dut, mode));
+      }
+    }
+  }
+}
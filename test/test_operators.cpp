@@ -40,3 +40,63 @@ SCENARIO("adding bit arrays") {
     }
   }
 }
+
+SCENARIO("repeating bit arrays") {
+  GIVEN("a period that does not divide the storage unit") {
+    auto ba = bitstring::bit_array("0b10011");
+    WHEN("repeating it often enough to need doubling of partial units") {
+      auto dut = 1000 * ba;
+      THEN("result must match repeated appending") {
+        auto expected = bitstring::bit_array();
+        for (int i = 0; i < 1000; i++) {
+          expected.append(ba);
+        }
+        REQUIRE(dut.size() == 5000);
+        REQUIRE(dut == expected);
+      }
+    }
+  }
+  GIVEN("a period that divides the storage unit") {
+    auto ba = bitstring::bit_array("0b01");
+    WHEN("repeating it to an odd length") {
+      auto dut = 37 * ba;
+      THEN("every unit must hold the pattern") {
+        REQUIRE(dut.size() == 74);
+        REQUIRE(dut.data()[0] == 0xaaaaaaaa);
+        REQUIRE(dut.data()[1] == 0xaaaaaaaa);
+      }
+      THEN("padding must be cleared") { REQUIRE(dut.data()[2] == 0x2aa); }
+      THEN("appending must continue after the pattern") {
+        dut.append(true);
+        REQUIRE(dut[74] == 1);
+        REQUIRE(dut.size() == 75);
+      }
+    }
+  }
+  GIVEN("a misaligned bit array") {
+    auto ba = bitstring::bit_array("0b110");
+    ba.prepend("0b0111");
+    WHEN("repeating it") {
+      auto dut = ba * 20;
+      THEN("result must match repeated appending") {
+        auto expected = bitstring::bit_array();
+        for (int i = 0; i < 20; i++) {
+          expected.append("0b0111110");
+        }
+        REQUIRE(dut == expected);
+      }
+    }
+  }
+  GIVEN("an empty bit array") {
+    WHEN("repeating it") {
+      auto dut = 5 * bitstring::bit_array();
+      THEN("result must be empty") { REQUIRE(dut.empty()); }
+    }
+  }
+  GIVEN("a bit array") {
+    WHEN("repeating it 0 times") {
+      auto dut = 0 * bitstring::bit_array("0b1101");
+      THEN("result must be empty") { REQUIRE(dut.empty()); }
+    }
+  }
+}
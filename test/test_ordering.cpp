@@ -0,0 +1,99 @@
+#include "bitstring/algorithm.hpp"
+#include "bitstring/bit_array.hpp"
+#include "bitstring/lfsr.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+SCENARIO("ordering bit arrays") {
+  GIVEN("bit arrays that differ in a single bit") {
+    const auto a = bitstring::bit_array("0b0110'1");
+    const auto b = bitstring::bit_array("0b0111'0");
+    THEN("the first differing bit must decide") {
+      REQUIRE(a < b);
+      REQUIRE(b > a);
+      REQUIRE(a <= b);
+      REQUIRE_FALSE(b <= a);
+      REQUIRE(bitstring::compare(a, b) < 0);
+      REQUIRE(bitstring::compare(a, a) == 0);
+#if defined(__cpp_impl_three_way_comparison) &&                               \
+    defined(__cpp_lib_three_way_comparison)
+      REQUIRE((a <=> b) == std::strong_ordering::less);
+#endif
+    }
+  }
+  GIVEN("a bit array and a proper prefix of it") {
+    const auto a = bitstring::bit_array("0b1011");
+    const auto b = bitstring::bit_array("0b10110");
+    THEN("the prefix must order first") {
+      REQUIRE(a < b);
+      REQUIRE(bitstring::bit_array() < a);
+      REQUIRE_FALSE(a < a);
+      REQUIRE(a >= a);
+    }
+  }
+  GIVEN("long bit arrays with different offsets") {
+    auto a = bitstring::prbs15().generate(300);
+    auto b = a;
+    b.prepend("0b1");
+    auto c = a;
+    c.append(false);
+    THEN("ordering must only depend on the bits") {
+      const auto b_view = b.view().subview(1, a.size());
+      REQUIRE_FALSE(a < b_view);
+      REQUIRE_FALSE(b_view < a);
+      REQUIRE(b_view < c);
+    }
+  }
+  GIVEN("all bit arrays up to 5 bits") {
+    std::vector<bitstring::bit_array> arrays;
+    for (size_t len = 0; len <= 5; len++) {
+      for (unsigned int v = 0; v < (1U << len); v++) {
+        arrays.emplace_back(v, len);
+      }
+    }
+    THEN("ordering must match ordering of bin strings") {
+      for (const auto &x : arrays) {
+        for (const auto &y : arrays) {
+          REQUIRE((x < y) == (x.bin() < y.bin()));
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("radix sorting bit arrays") {
+  GIVEN("many bit arrays with shared prefixes and different lengths") {
+    std::vector<bitstring::bit_array> arrays;
+    auto gen = bitstring::prbs15();
+    const auto prefix = gen.generate(37);
+    for (size_t i = 0; i < 3000; i++) {
+      auto a = i % 3 == 0 ? prefix : bitstring::bit_array();
+      a.append(gen.generate(i % 41));
+      arrays.push_back(a);
+      if (i % 5 == 0) {
+        arrays.push_back(a);
+      }
+    }
+    auto expected = arrays;
+    std::sort(expected.begin(), expected.end(),
+              [](const bitstring::bit_array &x,
+                 const bitstring::bit_array &y) { return x.bin() < y.bin(); });
+    WHEN("they are sorted") {
+      bitstring::radix_sort(arrays);
+      THEN("the order must match sorting by bin strings") {
+        REQUIRE(arrays == expected);
+      }
+    }
+  }
+  GIVEN("an empty vector") {
+    std::vector<bitstring::bit_array> arrays;
+    THEN("sorting must do nothing") {
+      bitstring::radix_sort(arrays);
+      REQUIRE(arrays.empty());
+    }
+  }
+}
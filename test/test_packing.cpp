@@ -0,0 +1,95 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/packing.hpp"
+#include "util.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+template <typename T> std::vector<T> random_values(size_t n) {
+  std::mt19937_64 gen(42);
+  std::vector<T> ret(n);
+  for (auto &v : ret) {
+    v = static_cast<T>(gen());
+  }
+  return ret;
+}
+
+template <typename T>
+bool packs_like_reference(const std::vector<T> &values,
+                          bitstring::bitorder bio) {
+  for (size_t width = 1; width <= 8 * sizeof(T); width++) {
+    auto expected = bitstring::bit_array();
+    for (auto v : values) {
+      expected.append(bitstring::bit_array(v, width, bio));
+    }
+    const auto packed = bitstring::pack(values, width, bio);
+    if (packed != expected) {
+      return false;
+    }
+    const auto mask = width == 64 ? ~uint64_t{0}
+                                  : (uint64_t{1} << width) - 1;
+    const auto unpacked = bitstring::unpack<T>(packed, width, bio);
+    if (unpacked.size() != values.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < values.size(); i++) {
+      if (unpacked[i] != (values[i] & mask)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+SCENARIO("packing integer arrays into fixed width bit fields") {
+  GIVEN("a few small values") {
+    const std::vector<uint8_t> values{1U, 2U, 3U, 4U};
+    THEN("they must be packed back to back") {
+      REQUIRE(bitstring::pack(values, 3) ==
+              bitstring::bit_array("0b100'010'110'001"));
+      REQUIRE(bitstring::pack(values, 3, bitstring::bitorder::msb_first) ==
+              bitstring::bit_array("0b001'010'011'100"));
+    }
+    THEN("bits above the width must be dropped") {
+      REQUIRE(bitstring::pack(values, 1) == bitstring::bit_array("0b1010"));
+    }
+  }
+  GIVEN("random values of every type") {
+    const auto u8 = random_values<uint8_t>(67);
+    const auto u16 = random_values<uint16_t>(67);
+    const auto u32 = random_values<uint32_t>(67);
+    const auto u64 = random_values<uint64_t>(67);
+    THEN("every width must match the integer constructor and round trip") {
+      for (auto bio :
+           {bitstring::bitorder::lsb_first, bitstring::bitorder::msb_first}) {
+        REQUIRE(packs_like_reference(u8, bio));
+        REQUIRE(packs_like_reference(u16, bio));
+        REQUIRE(packs_like_reference(u32, bio));
+        REQUIRE(packs_like_reference(u64, bio));
+      }
+    }
+  }
+  GIVEN("a misaligned view") {
+    auto bits = bitstring::bit_array("0b101");
+    bits.append(bitstring::pack(std::vector<uint16_t>{0x3ffU, 0x155U}, 10));
+    THEN("it must be unpacked correctly") {
+      REQUIRE(bitstring::unpack<uint16_t>(bits.view().subview(3, 20), 10) ==
+              std::vector<uint16_t>{0x3ffU, 0x155U});
+    }
+  }
+  GIVEN("invalid widths") {
+    const std::vector<uint8_t> values{1U};
+    THEN("packing and unpacking must throw") {
+      REQUIRE_THROWS_AS(bitstring::pack(values, 0), std::invalid_argument);
+      REQUIRE_THROWS_AS(bitstring::pack(values, 9), std::invalid_argument);
+      REQUIRE_THROWS_AS(
+          bitstring::unpack<uint8_t>(bitstring::bit_array("0b1010"), 3),
+          std::invalid_argument);
+    }
+  }
+}
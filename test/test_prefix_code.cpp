@@ -0,0 +1,115 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/bit_stream.hpp"
+#include "bitstring/exceptions.hpp"
+#include "bitstring/prefix_code.hpp"
+#include "util.hpp"
+
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+using codes_t = std::vector<
+    std::pair<bitstring::bit_array, bitstring::prefix_code::symbol_type>>;
+
+SCENARIO("reading bits from a bit stream") {
+  GIVEN("a reader over a misaligned view") {
+    auto bits = bitstring::bit_array("0b1");
+    bits.append(bitstring::bit_array(0x1234'5678'9abc'def0U, 64));
+    auto dut = bitstring::bit_reader(bits.view().subview(1, 64));
+    THEN("bits must be read in order") {
+      REQUIRE(dut.peek(4) == 0x0U);
+      REQUIRE(dut.read(8) == 0xf0U);
+      REQUIRE(dut.read(40) == 0x5678'9abc'deU);
+      REQUIRE(dut.position() == 48);
+      REQUIRE(dut.peek(32) == 0x1234U);
+      REQUIRE(dut.read(16) == 0x1234U);
+      REQUIRE(dut.empty());
+      REQUIRE_THROWS_AS(dut.read(1), bitstring::decode_error);
+    }
+  }
+}
+
+SCENARIO("decoding prefix codes") {
+  GIVEN("a small huffman code") {
+    const codes_t codes{{bitstring::bit_array("0b0"), 'a'},
+                        {bitstring::bit_array("0b10"), 'b'},
+                        {bitstring::bit_array("0b110"), 'c'},
+                        {bitstring::bit_array("0b111"), 'd'}};
+    const auto dut = bitstring::prefix_code(codes);
+    THEN("a bit sequence must decode to its symbols") {
+      REQUIRE(dut.decode(bitstring::bit_array("0b0'10'110'111'0")) ==
+              std::vector<uint32_t>{'a', 'b', 'c', 'd', 'a'});
+    }
+    THEN("a truncated codeword must be rejected") {
+      REQUIRE_THROWS_AS(dut.decode(bitstring::bit_array("0b0'11")),
+                        bitstring::decode_error);
+    }
+    THEN("batch decoding must stop at the requested count") {
+      const auto bits = bitstring::bit_array("0b10'10'0");
+      auto reader = bitstring::bit_reader(bits);
+      uint32_t out[2] = {};
+      REQUIRE(dut.decode(reader, out, 2) == 2);
+      REQUIRE(out[1] == 'b');
+      REQUIRE(dut.decode(reader) == 'a');
+      REQUIRE(dut.decode(reader, out, 2) == 0);
+    }
+  }
+  GIVEN("codewords longer than the root table") {
+    // unary style code: 1^k 0 for k < 20, plus an all ones codeword
+    codes_t codes;
+    for (uint32_t k = 0; k < 20; k++) {
+      auto word = bitstring::bit_array();
+      for (uint32_t i = 0; i < k; i++) {
+        word.append(true);
+      }
+      word.append(false);
+      codes.emplace_back(word, k);
+    }
+    codes.emplace_back(bitstring::bit_array("0b1111'1111'1111'1111'1111"),
+                       99);
+    const auto dut = bitstring::prefix_code(codes, 4);
+    THEN("they must be resolved through subtables") {
+      auto bits = bitstring::bit_array();
+      std::vector<uint32_t> expected;
+      for (uint32_t k : {3U, 19U, 0U, 7U, 12U}) {
+        bits.append(codes[k].first);
+        expected.push_back(k);
+      }
+      bits.append(codes.back().first);
+      expected.push_back(99);
+      REQUIRE(dut.decode(bits) == expected);
+    }
+    THEN("truncation inside a subtable must be rejected") {
+      REQUIRE_THROWS_AS(dut.decode(bitstring::bit_array("0b1111'11")),
+                        bitstring::decode_error);
+    }
+  }
+  GIVEN("an incomplete code") {
+    const codes_t codes{{bitstring::bit_array("0b00"), 1},
+                        {bitstring::bit_array("0b01"), 2}};
+    const auto dut = bitstring::prefix_code(codes);
+    THEN("bits that start no codeword must be rejected") {
+      REQUIRE_THROWS_AS(dut.decode(bitstring::bit_array("0b00'10")),
+                        bitstring::decode_error);
+    }
+  }
+  GIVEN("invalid codes") {
+    const codes_t prefixed{{bitstring::bit_array("0b1"), 1},
+                           {bitstring::bit_array("0b10"), 2}};
+    const codes_t long_prefixed{
+        {bitstring::bit_array("0b11"), 1},
+        {bitstring::bit_array("0b1100'0000'0000'0000"), 2}};
+    const codes_t empty{{bitstring::bit_array(), 1}};
+    THEN("building the decoder must throw") {
+      REQUIRE_THROWS_AS(bitstring::prefix_code(prefixed),
+                        std::invalid_argument);
+      REQUIRE_THROWS_AS(bitstring::prefix_code(long_prefixed, 8),
+                        std::invalid_argument);
+      REQUIRE_THROWS_AS(bitstring::prefix_code(empty),
+                        std::invalid_argument);
+      REQUIRE_THROWS_AS(bitstring::prefix_code(codes_t{}, 0),
+                        std::invalid_argument);
+    }
+  }
+}
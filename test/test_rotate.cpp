@@ -0,0 +1,93 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/lfsr.hpp"
+#include "util.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+bitstring::bit_array reference_rotate_left(const bitstring::bit_array &a,
+                                           size_t n) {
+  auto ret = bitstring::bit_array();
+  for (size_t i = 0; i < a.size(); i++) {
+    ret.append(a[(i + n) % a.size()] != 0);
+  }
+  return ret;
+}
+
+bitstring::bit_array reference_reverse(const bitstring::bit_array &a) {
+  auto ret = bitstring::bit_array();
+  for (size_t i = a.size(); i > 0; i--) {
+    ret.append(a[i - 1] != 0);
+  }
+  return ret;
+}
+} // namespace
+
+SCENARIO("rotating bit arrays") {
+  GIVEN("a short bit array") {
+    auto dut = bitstring::bit_array("0b110100");
+    THEN("rotating must move bits around the ends") {
+      REQUIRE(dut.rotate_left(2) == bitstring::bit_array("0b010011"));
+      REQUIRE(dut.rotate_right(3) == bitstring::bit_array("0b011010"));
+      REQUIRE(dut.rotate_right(7) == bitstring::bit_array("0b001101"));
+      REQUIRE(dut.rotate_left(6) == bitstring::bit_array("0b001101"));
+    }
+  }
+  GIVEN("bit arrays of various sizes and offsets") {
+    THEN("rotations must match the per bit reference") {
+      for (size_t size : {1U, 31U, 32U, 33U, 100U, 257U}) {
+        auto base = bitstring::prbs15().generate(size);
+        base.prepend("0b101");
+        base = bitstring::bit_array(base.view().subview(3, size));
+        for (size_t n : {0U, 1U, 5U, 31U, 32U, 64U, 99U, 200U, 256U}) {
+          auto dut = base;
+          REQUIRE(dut.rotate_left(n) == reference_rotate_left(base, n));
+          dut = base;
+          REQUIRE(dut.rotate_right(n) ==
+                  reference_rotate_left(base, size - n % size));
+        }
+      }
+    }
+    THEN("repeated rotations must not accumulate storage") {
+      auto dut = bitstring::prbs7().generate(100);
+      const auto expected = dut;
+      for (size_t i = 0; i < 1000; i++) {
+        dut.rotate_left(7);
+      }
+      dut.rotate_right(7000);
+      REQUIRE(dut == expected);
+      REQUIRE(dut.data().size() <= 2 * 4 + 1);
+    }
+  }
+}
+
+SCENARIO("reversing bit arrays") {
+  GIVEN("a short bit array") {
+    auto dut = bitstring::bit_array("0b110100");
+    THEN("the bit order must be reversed") {
+      REQUIRE(dut.reverse() == bitstring::bit_array("0b001011"));
+      REQUIRE(dut.reverse() == bitstring::bit_array("0b110100"));
+    }
+  }
+  GIVEN("bit arrays of various sizes with an offset") {
+    THEN("reversal must match the per bit reference") {
+      for (size_t size : {1U, 31U, 32U, 33U, 100U, 257U}) {
+        auto dut = bitstring::prbs15().generate(size);
+        dut.prepend("0b10110");
+        const auto expected = reference_reverse(dut);
+        REQUIRE(dut.reverse() == expected);
+        dut.append("0b111");
+        REQUIRE(dut.size() == size + 8);
+        REQUIRE(dut.view().subview(0, size + 5) == expected);
+      }
+    }
+  }
+  GIVEN("a bit array built from bytes") {
+    auto dut = bitstring::bit_array(std::vector<uint8_t>{0x12, 0x34});
+    THEN("reversal must convert between LSB and MSB first streams") {
+      REQUIRE(dut.reverse() == bitstring::bit_array(
+                                   uint16_t{0x3412},
+                                   bitstring::bitorder::msb_first));
+    }
+  }
+}
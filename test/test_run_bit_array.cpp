@@ -0,0 +1,114 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/lfsr.hpp"
+#include "bitstring/run_bit_array.hpp"
+#include "util.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+// idle line with a few bursts of data
+bitstring::bit_array idle_capture() {
+  auto ret = bitstring::bit_array();
+  auto data = bitstring::prbs7();
+  for (size_t burst = 0; burst < 5; burst++) {
+    for (size_t i = 0; i < 1000 + burst * 7; i++) {
+      ret.append(true);
+    }
+    ret.append(data.generate(40 + burst));
+  }
+  return ret;
+}
+} // namespace
+
+SCENARIO("converting run length compressed bit arrays") {
+  GIVEN("an idle capture") {
+    auto dut = idle_capture();
+    dut.prepend("0b00");
+    auto compressed = bitstring::run_bit_array(dut);
+    THEN("it must round trip") {
+      REQUIRE(compressed.size() == dut.size());
+      REQUIRE(compressed.to_bit_array() == dut);
+    }
+    THEN("it must use far fewer runs than bits") {
+      REQUIRE(compressed.run_count() * 10 < dut.size());
+    }
+    THEN("bits and the count must match") {
+      size_t expected = 0;
+      for (size_t i = 0; i < dut.size(); i++) {
+        REQUIRE(compressed[i] == dut[i]);
+        expected += dut[i];
+      }
+      REQUIRE(compressed.count() == expected);
+    }
+    THEN("runs must cover the array with alternating values") {
+      size_t pos = 0;
+      bool last = !compressed[0];
+      for (auto r : compressed.runs()) {
+        REQUIRE(r.pos == pos);
+        REQUIRE(r.length != 0);
+        REQUIRE(r.value != last);
+        pos += r.length;
+        last = r.value;
+      }
+      REQUIRE(pos == dut.size());
+    }
+  }
+  GIVEN("an empty bit array") {
+    auto compressed = bitstring::run_bit_array(bitstring::bit_array());
+    THEN("it must be empty") {
+      REQUIRE(compressed.empty());
+      REQUIRE(compressed.count() == 0);
+      REQUIRE(compressed.to_bit_array().empty());
+      REQUIRE(compressed == bitstring::run_bit_array());
+    }
+  }
+}
+
+SCENARIO("building run length compressed bit arrays") {
+  GIVEN("runs appended one after another") {
+    auto dut = bitstring::run_bit_array();
+    dut.append(false, 3).append(false, 2).append(true, 0).append(true);
+    THEN("neighbouring runs with the same value must be merged") {
+      REQUIRE(dut.run_count() == 2);
+      const auto expected = bitstring::bit_array("0b000001");
+      REQUIRE(dut == bitstring::run_bit_array(expected));
+    }
+  }
+}
+
+SCENARIO("logical operations on run length compressed bit arrays") {
+  GIVEN("two compressed arrays of the same size") {
+    auto a = idle_capture();
+    auto b = bitstring::prbs15().generate(3000);
+    while (b.size() < a.size()) {
+      b.append(false);
+    }
+    const auto ra = bitstring::run_bit_array(a);
+    const auto rb = bitstring::run_bit_array(b);
+    THEN("results must match the uncompressed operations") {
+      const auto check = [&](const bitstring::run_bit_array &result,
+                             auto op) {
+        REQUIRE(result.size() == a.size());
+        for (size_t i = 0; i < a.size(); i++) {
+          REQUIRE(result[i] == op(a[i], b[i]));
+        }
+        REQUIRE(result == bitstring::run_bit_array(result.to_bit_array()));
+      };
+      check(ra & rb, [](uint8_t x, uint8_t y) { return x & y; });
+      check(ra | rb, [](uint8_t x, uint8_t y) { return x | y; });
+      check(ra ^ rb, [](uint8_t x, uint8_t y) { return x ^ y; });
+      check(~ra, [](uint8_t x, uint8_t) { return x ^ 1; });
+    }
+    THEN("xor with itself must leave a single run") {
+      REQUIRE((ra ^ ra).run_count() == 1);
+      REQUIRE((ra ^ ra).count() == 0);
+    }
+  }
+  GIVEN("arrays of different size") {
+    const auto a = bitstring::run_bit_array(bitstring::bit_array("0b0110"));
+    const auto b = bitstring::run_bit_array(bitstring::bit_array("0b011"));
+    THEN("operations must throw") {
+      REQUIRE_THROWS_AS(a & b, std::length_error);
+    }
+  }
+}
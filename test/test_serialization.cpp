@@ -0,0 +1,97 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/exceptions.hpp"
+#include "bitstring/lfsr.hpp"
+#include "bitstring/serialization.hpp"
+#include "util.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+SCENARIO("serializing single bit arrays") {
+  GIVEN("a short bit array") {
+    const auto dut = bitstring::bit_array("0b1011'0000'1");
+    THEN("the record must hold the length and bytes LSB first") {
+      const auto expected = std::vector<std::uint8_t>{9, 0x0d, 0x01};
+      REQUIRE(bitstring::serialize(dut) == expected);
+      REQUIRE(bitstring::serialized_size(dut) == expected.size());
+    }
+  }
+  GIVEN("bit arrays of various lengths and offsets") {
+    auto source = bitstring::prbs15().generate(2000);
+    THEN("they must round trip through bytes and streams") {
+      for (size_t len : {0U, 1U, 8U, 31U, 127U, 128U, 1999U}) {
+        const auto view = source.view().subview(1, len);
+        const auto bytes = bitstring::serialize(view);
+        size_t consumed = 0;
+        REQUIRE(bitstring::deserialize(bytes.data(), bytes.size(),
+                                       &consumed) == view);
+        REQUIRE(consumed == bytes.size());
+
+        std::stringstream ss;
+        bitstring::serialize(ss, view);
+        bitstring::serialize(ss, source);
+        REQUIRE(bitstring::deserialize(ss) == view);
+        REQUIRE(bitstring::deserialize(ss) == source);
+      }
+    }
+  }
+  GIVEN("a truncated record") {
+    auto bytes = bitstring::serialize(bitstring::bit_array("0b1011'0000'1"));
+    bytes.pop_back();
+    THEN("decoding must throw") {
+      REQUIRE_THROWS_AS(bitstring::deserialize(bytes.data(), bytes.size()),
+                        bitstring::decode_error);
+      std::stringstream ss(std::string(bytes.begin(), bytes.end()));
+      REQUIRE_THROWS_AS(bitstring::deserialize(ss), bitstring::decode_error);
+    }
+  }
+}
+
+SCENARIO("serializing batches of bit arrays") {
+  GIVEN("a batch written to a stream") {
+    std::vector<bitstring::bit_array> arrays;
+    auto gen = bitstring::prbs7();
+    for (size_t i = 0; i < 300; i++) {
+      arrays.push_back(gen.generate(i % 77));
+    }
+    std::stringstream ss;
+    auto writer = bitstring::batch_writer(ss);
+    for (const auto &a : arrays) {
+      writer.append(a);
+    }
+    writer.finish();
+    const auto bytes = ss.str();
+
+    THEN("reading it must return the same arrays") {
+      REQUIRE(bitstring::read_batch(ss) == arrays);
+    }
+    THEN("a view on an aligned copy must show the same arrays") {
+      std::vector<std::uint32_t> aligned(bytes.size() / 4 + 1);
+      std::memcpy(aligned.data(), bytes.data(), bytes.size());
+      const auto view = bitstring::batch_view(aligned.data(), bytes.size());
+      REQUIRE(view.size() == arrays.size());
+      for (size_t i = 0; i < arrays.size(); i++) {
+        REQUIRE(view[i] == arrays[i]);
+      }
+    }
+    THEN("a damaged batch must be rejected") {
+      std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+      REQUIRE_THROWS_AS(bitstring::read_batch(truncated),
+                        bitstring::decode_error);
+      std::stringstream not_a_batch("BSTX" + bytes.substr(4));
+      REQUIRE_THROWS_AS(bitstring::read_batch(not_a_batch),
+                        bitstring::decode_error);
+    }
+  }
+  GIVEN("an empty batch") {
+    std::stringstream ss;
+    bitstring::batch_writer(ss).finish();
+    THEN("it must read back empty") {
+      REQUIRE(ss.str().size() == 24);
+      REQUIRE(bitstring::read_batch(ss).empty());
+    }
+  }
+}
@@ -0,0 +1,82 @@
+#include "bitstring/bit_array.hpp"
+#include "bitstring/stats.hpp"
+#include "util.hpp"
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+std::vector<bitstring::stats::event> traced;
+void trace(const bitstring::stats::event &e) { traced.push_back(e); }
+} // namespace
+
+SCENARIO("collecting statistics of bit_array operations") {
+  using bitstring::stats::op;
+  GIVEN("reset counters") {
+    bitstring::stats::reset();
+    WHEN("bits are appended one at a time") {
+      auto dut = bitstring::bit_array();
+      for (size_t i = 0; i < 100; i++) {
+        dut.append(true);
+      }
+      const auto stats = bitstring::stats::take_snapshot();
+      THEN("calls and reallocations must be counted if enabled") {
+        const auto &c = stats[op::append_bit];
+        if (bitstring::stats::enabled) {
+          REQUIRE(c.calls == 100);
+          REQUIRE(c.bits == 100);
+          REQUIRE(c.allocations >= 1);
+          REQUIRE(c.allocations <= 4);
+          REQUIRE(c.allocated_bytes >= 16);
+        } else {
+          REQUIRE(c.calls == 0);
+          REQUIRE(c.allocations == 0);
+        }
+      }
+    }
+    WHEN("arrays with different offsets are compared") {
+      auto a = bitstring::bit_array("0b1011");
+      auto b = bitstring::bit_array("0b1011");
+      const auto aligned = a == b;
+      b.reserve_front(3);
+      const auto unaligned = a == b;
+      const auto stats = bitstring::stats::take_snapshot();
+      THEN("the slow path must be counted if enabled") {
+        REQUIRE(aligned);
+        REQUIRE(unaligned);
+        const auto expected = bitstring::stats::enabled ? 1U : 0U;
+        REQUIRE(stats[op::compare].calls == 2 * expected);
+        REQUIRE(stats[op::compare].slow_paths == expected);
+        REQUIRE(stats[op::reserve_front].allocations == expected);
+        REQUIRE(stats[op::parse].calls == 2 * expected);
+      }
+    }
+    WHEN("a tracing hook is installed") {
+      traced.clear();
+      bitstring::stats::set_trace_hook(&trace);
+      auto dut = bitstring::bit_array("0b1100");
+      dut.append(dut.view());
+      bitstring::stats::set_trace_hook(nullptr);
+      dut.reverse();
+      THEN("it must see every recorded operation if enabled") {
+        if (bitstring::stats::enabled) {
+          REQUIRE(traced.size() == 2);
+          REQUIRE(traced[0].operation == op::parse);
+          REQUIRE(traced[1].operation == op::append);
+          REQUIRE(traced[1].bits == 4);
+          REQUIRE(traced[1].slow_path);
+        } else {
+          REQUIRE(traced.empty());
+        }
+        REQUIRE(dut == bitstring::bit_array("0b0011'0011"));
+      }
+    }
+  }
+  GIVEN("the operation names") {
+    THEN("they must match the enumerators") {
+      REQUIRE(std::string(bitstring::stats::name(op::parse)) == "parse");
+      REQUIRE(std::string(bitstring::stats::name(op::repeat)) == "repeat");
+    }
+  }
+}